@@ -329,6 +329,15 @@ namespace MaxMix.Services.Communication
                 case Command.MODE_STATES:
                     ReadMessage<ModeStates>(now, command);
                     break;
+                case Command.PROBE:
+                    ReadMessage<ProbeData>(now, command);
+                    break;
+                case Command.STATS:
+                    ReadMessage<LinkStats>(now, command);
+                    break;
+                case Command.DIAGNOSTICS:
+                    ReadMessage<Diagnostics>(now, command);
+                    break;
                 case Command.ERROR:
                 case Command.NONE:
                 case Command.DEBUG:
@@ -412,6 +421,10 @@ namespace MaxMix.Services.Communication
                 case Command.VOLUME_NEXT_CHANGE:
                 case Command.MODE_STATES:
                 case Command.DEBUG:
+                case Command.PROBE:
+                case Command.STATS:
+                case Command.DIAGNOSTICS:
+                case Command.PEAK_LEVELS:
                     WriteMessage(now, pair.Key, pair.Value);
                     break;
                 case Command.ERROR:
@@ -13,13 +13,8 @@ namespace MaxMix.Services.Communication
 #if DEBUG
             "0.0.0",
 #endif
-            "1.5.0",
-            "1.5.1",
-            "1.5.2",
-            "1.5.3",
-            "1.5.4",
-            "1.5.5",
-            "1.5.6"
+            // 1.6.0 added the lighting effects to DeviceSettings, older firmware reads a shorter SETTINGS.
+            "1.6.0"
         };
 
         public static bool IsCompatible(string version)
@@ -21,7 +21,11 @@ namespace MaxMix.Services.Communication
         VOLUME_PREV_CHANGE,
         VOLUME_NEXT_CHANGE,
         MODE_STATES,
-        DEBUG
+        DEBUG,
+        PROBE,
+        STATS,
+        DIAGNOSTICS,
+        PEAK_LEVELS
     }
 
     public enum SessionIndex
@@ -43,6 +47,18 @@ namespace MaxMix.Services.Communication
         MODE_MAX
     };
 
+    // Byte sized, it is a field of DeviceSettings.
+    public enum LightingEffect : byte
+    {
+        EFFECT_OFF,
+        EFFECT_PULSE,
+        EFFECT_BREATHE,
+        EFFECT_SPIN,
+        EFFECT_RAINBOW,
+        EFFECT_FADE_OUT,
+        EFFECT_MAX
+    };
+
     public enum SplashState
     {
         STATE_LOGO,
@@ -395,6 +411,9 @@ namespace MaxMix.Services.Communication
         public Color volumeMaxColor;
         public Color mixChannelAColor;
         public Color mixChannelBColor;
+        public LightingEffect muteEffect;
+        public LightingEffect splashEffect;
+        public LightingEffect sleepEffect;
 
         public static DeviceSettings Default()
         {
@@ -406,7 +425,10 @@ namespace MaxMix.Services.Communication
                 volumeMinColor = new Color(0, 0, 255),
                 volumeMaxColor = new Color(255, 0, 0),
                 mixChannelAColor = new Color(0, 0, 255),
-                mixChannelBColor = new Color(255, 0, 255)
+                mixChannelBColor = new Color(255, 0, 255),
+                muteEffect = LightingEffect.EFFECT_PULSE,
+                splashEffect = LightingEffect.EFFECT_SPIN,
+                sleepEffect = LightingEffect.EFFECT_FADE_OUT
             };
         }
 
@@ -427,7 +449,7 @@ namespace MaxMix.Services.Communication
 
         public override string ToString()
         {
-            return $"{sleepAfterSeconds}, {accelerationPercentage}, {continuousScroll}, {volumeMinColor}, {volumeMaxColor}, {mixChannelAColor}, {mixChannelBColor} > {this.ToByteString()}";
+            return $"{sleepAfterSeconds}, {accelerationPercentage}, {continuousScroll}, {volumeMinColor}, {volumeMaxColor}, {mixChannelAColor}, {mixChannelBColor}, {muteEffect}, {splashEffect}, {sleepEffect} > {this.ToByteString()}";
         }
     }
 
@@ -497,4 +519,212 @@ namespace MaxMix.Services.Communication
             return $"{splash}, {output}, {input}, {application}, {game} > {this.ToByteString()}";
         }
     }
+
+    public unsafe struct ProbeData : IMessage, IEquatable<ProbeData>
+    {
+        fixed byte m_Data[12];
+
+        public uint hostTime
+        {
+            get { fixed (byte* ptr = m_Data) return *(uint*)ptr; }
+            set { fixed (byte* ptr = m_Data) *(uint*)ptr = value; }
+        }
+
+        public uint deviceTime
+        {
+            get { fixed (byte* ptr = m_Data) return *(uint*)(ptr + 4); }
+        }
+
+        public uint queuedTime
+        {
+            get { fixed (byte* ptr = m_Data) return *(uint*)(ptr + 8); }
+        }
+
+        public static ProbeData Default()
+        {
+            return new ProbeData();
+        }
+
+        public bool Equals(ProbeData other)
+        {
+            return this.UnsafeEquals(other);
+        }
+
+        // The host only sends its own timestamp, the device fills in the rest of the reply.
+        public unsafe void GetBytes(MemoryStream stream)
+        {
+            this.UnsafeCopyTo(stream, 0, 4);
+        }
+
+        public void SetBytes(byte[] bytes)
+        {
+            this.UnsafeCopyFrom(bytes);
+        }
+
+        public override string ToString()
+        {
+            return $"{hostTime}, {deviceTime}, {queuedTime} > {this.ToByteString()}";
+        }
+    }
+
+    public unsafe struct LinkStats : IMessage, IEquatable<LinkStats>
+    {
+        fixed byte m_Data[18];
+
+        public uint bytesRead
+        {
+            get { fixed (byte* ptr = m_Data) return *(uint*)ptr; }
+        }
+
+        public uint bytesWritten
+        {
+            get { fixed (byte* ptr = m_Data) return *(uint*)(ptr + 4); }
+        }
+
+        public ushort framesRead
+        {
+            get { fixed (byte* ptr = m_Data) return *(ushort*)(ptr + 8); }
+        }
+
+        public ushort framesWritten
+        {
+            get { fixed (byte* ptr = m_Data) return *(ushort*)(ptr + 10); }
+        }
+
+        public ushort sizeErrors
+        {
+            get { fixed (byte* ptr = m_Data) return *(ushort*)(ptr + 12); }
+        }
+
+        public ushort unknownCommands
+        {
+            get { fixed (byte* ptr = m_Data) return *(ushort*)(ptr + 14); }
+        }
+
+        public ushort overflows
+        {
+            get { fixed (byte* ptr = m_Data) return *(ushort*)(ptr + 16); }
+        }
+
+        public static LinkStats Default()
+        {
+            return new LinkStats();
+        }
+
+        public bool Equals(LinkStats other)
+        {
+            return this.UnsafeEquals(other);
+        }
+
+        // Requesting stats carries no payload.
+        public unsafe void GetBytes(MemoryStream stream)
+        {
+        }
+
+        public void SetBytes(byte[] bytes)
+        {
+            this.UnsafeCopyFrom(bytes);
+        }
+
+        public override string ToString()
+        {
+            return $"{bytesRead}, {bytesWritten}, {framesRead}, {framesWritten}, {sizeErrors}, {unknownCommands}, {overflows} > {this.ToByteString()}";
+        }
+    }
+
+    public unsafe struct Diagnostics : IMessage, IEquatable<Diagnostics>
+    {
+        fixed byte m_Data[10];
+
+        public ushort encoderInvalid
+        {
+            get { fixed (byte* ptr = m_Data) return *(ushort*)ptr; }
+        }
+
+        public ushort timerMissed
+        {
+            get { fixed (byte* ptr = m_Data) return *(ushort*)(ptr + 2); }
+        }
+
+        public ushort timerLateMax
+        {
+            get { fixed (byte* ptr = m_Data) return *(ushort*)(ptr + 4); }
+        }
+
+        public ushort pixelsShowMax
+        {
+            get { fixed (byte* ptr = m_Data) return *(ushort*)(ptr + 6); }
+        }
+
+        public ushort inputOverflows
+        {
+            get { fixed (byte* ptr = m_Data) return *(ushort*)(ptr + 8); }
+        }
+
+        public static Diagnostics Default()
+        {
+            return new Diagnostics();
+        }
+
+        public bool Equals(Diagnostics other)
+        {
+            return this.UnsafeEquals(other);
+        }
+
+        // Requesting diagnostics carries no payload.
+        public unsafe void GetBytes(MemoryStream stream)
+        {
+        }
+
+        public void SetBytes(byte[] bytes)
+        {
+            this.UnsafeCopyFrom(bytes);
+        }
+
+        public override string ToString()
+        {
+            return $"{encoderInvalid}, {timerMissed}, {timerLateMax}, {pixelsShowMax}, {inputOverflows} > {this.ToByteString()}";
+        }
+    }
+
+    public unsafe struct PeakLevels : IMessage, IEquatable<PeakLevels>
+    {
+        fixed byte m_Data[2];
+
+        // 4 bits per SessionIndex, 0-15.
+        public byte this[SessionIndex index]
+        {
+            get => (byte)((m_Data[(int)index >> 1] >> (((int)index & 1) * 4)) & 0x0F);
+            set
+            {
+                int shift = ((int)index & 1) * 4;
+                m_Data[(int)index >> 1] = (byte)((m_Data[(int)index >> 1] & ~(0x0F << shift)) | (Math.Min(value, (byte)15) << shift));
+            }
+        }
+
+        public static PeakLevels Default()
+        {
+            return new PeakLevels();
+        }
+
+        public bool Equals(PeakLevels other)
+        {
+            return this.UnsafeEquals(other);
+        }
+
+        public unsafe void GetBytes(MemoryStream stream)
+        {
+            this.UnsafeCopyTo(stream);
+        }
+
+        public void SetBytes(byte[] bytes)
+        {
+            this.UnsafeCopyFrom(bytes);
+        }
+
+        public override string ToString()
+        {
+            return $"{this[SessionIndex.INDEX_CURRENT]}, {this[SessionIndex.INDEX_ALTERNATE]}, {this[SessionIndex.INDEX_PREVIOUS]}, {this[SessionIndex.INDEX_NEXT]} > {this.ToByteString()}";
+        }
+    }
 }
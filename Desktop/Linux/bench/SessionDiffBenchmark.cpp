@@ -0,0 +1,173 @@
+//********************************************************
+// PROJECT: MAXMIX
+//
+// DECRIPTION:
+// Runs SessionDiff over randomly changing session lists of
+// several sizes. Every batch is applied to a model of the
+// firmware and checked against a full refresh, then the time
+// and bytes per update are reported next to the desktop
+// application's full refresh (3 SessionData + SESSION_INFO).
+// Lists longer than SESSIONS_MAX are shown up to it.
+//
+// USAGE:
+// session-diff-benchmark [ITERATIONS]
+//********************************************************
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <vector>
+
+#include "SessionDiff.h"
+
+// What the firmware does with each message, see Communications::Read.
+struct DeviceModel
+{
+    SessionInfo info;
+    SessionData sessions[SessionIndex::INDEX_MAX];
+
+    void Apply(const MessageBatch &batch)
+    {
+        for (uint8_t i = 0; i < batch.count; i++)
+        {
+            const MessageBatch::Message &message = batch.messages[i];
+            if (message.command == Command::SESSION_INFO)
+                memcpy(&info, message.payload, sizeof(SessionInfo));
+            else if (message.command >= Command::CURRENT_SESSION && message.command <= Command::NEXT_SESSION)
+                memcpy(&sessions[message.command - Command::CURRENT_SESSION], message.payload, sizeof(SessionData));
+            else if (message.command >= Command::VOLUME_CURR_CHANGE && message.command <= Command::VOLUME_NEXT_CHANGE)
+                memcpy(&sessions[message.command - Command::VOLUME_CURR_CHANGE].data, message.payload, sizeof(VolumeData));
+        }
+    }
+
+    // Compared field by field instead of against ToSessionData, an id that doesn't fit is an error.
+    bool Shows(const std::vector<Session> &list) const
+    {
+        // Only the first SESSIONS_MAX sessions can be addressed by the device.
+        size_t count = std::min(list.size(), SESSIONS_MAX);
+        size_t current = info.current;
+        if (current >= count)
+            return false;
+
+        const size_t indexes[3] = {current, (current + count - 1) % count, (current + 1) % count};
+        const SessionIndex slots[3] = {SessionIndex::INDEX_CURRENT, SessionIndex::INDEX_PREVIOUS, SessionIndex::INDEX_NEXT};
+        for (uint8_t i = 0; i < 3; i++)
+        {
+            const SessionData &shown = sessions[slots[i]];
+            const Session &session = list[indexes[i]];
+            if (strncmp(shown.name, session.name.c_str(), sizeof(shown.name) - 1) != 0 || shown.data.id != indexes[i] ||
+                shown.data.isDefault != session.isDefault || shown.data.volume != session.volume || shown.data.isMuted != session.isMuted)
+                return false;
+        }
+        return info.sessions[2] == count;
+    }
+};
+
+struct Result
+{
+    double nanoseconds;
+    double bytes;
+    double messages;
+    uint32_t errors;
+};
+
+static Result Run(size_t size, uint32_t iterations, std::mt19937 &random)
+{
+    std::vector<Session> previous, next;
+    int nextId = 1;
+    for (size_t i = 0; i < size; i++)
+    {
+        Session session;
+        session.id = nextId++;
+        session.name = "Application " + std::to_string(session.id);
+        session.volume = random() % 101;
+        next.push_back(session);
+    }
+
+    DeviceView device;
+    device.info.mode = DisplayMode::MODE_APPLICATION;
+    device.info.current = random() % std::min(size, SESSIONS_MAX);
+    device.Invalidate();
+    DeviceModel model;
+    memcpy((void *)&model, (const void *)&device, sizeof(model));
+
+    uint8_t counts[3] = {2, 1, 0};
+    MessageBatch batch;
+    Result result = {};
+    std::chrono::nanoseconds elapsed(0);
+    for (uint32_t i = 0; i < iterations; i++)
+    {
+        previous = next;
+        int focusId = -1;
+        uint32_t change = random() % 100;
+        size_t index = random() % next.size();
+        if (change < 60)
+        {
+            next[index].volume = random() % 101;
+            next[index].isMuted = random() % 8 == 0;
+        }
+        else if (change < 75)
+        {
+            // Ids only grow so the list stays ordered, new sessions are focused half the time.
+            Session session;
+            session.id = nextId++;
+            session.name = "Application " + std::to_string(session.id);
+            session.volume = random() % 101;
+            next.push_back(session);
+            if (random() % 2)
+                focusId = session.id;
+        }
+        else if (change < 90 && next.size() > 3)
+        {
+            next.erase(next.begin() + index);
+        }
+        else
+        {
+            for (Session &session : next)
+                session.isDefault = false;
+            next[index].isDefault = true;
+        }
+        // Lists keep around their starting size, counts are narrowed like the backend's but not capped, Flush does that.
+        if (next.size() > 255 && next.size() > size)
+            next.erase(next.begin() + next.size() / 2);
+        counts[2] = next.size() > 255 ? 255 : next.size();
+
+        batch.Clear();
+        auto start = std::chrono::steady_clock::now();
+        SessionDiff::Update(device, previous, next, counts, focusId, batch);
+        elapsed += std::chrono::steady_clock::now() - start;
+
+        result.bytes += batch.GetSize();
+        result.messages += batch.count;
+        model.Apply(batch);
+        if (!model.Shows(next))
+            result.errors++;
+    }
+
+    result.nanoseconds = (double)elapsed.count() / iterations;
+    result.bytes /= iterations;
+    result.messages /= iterations;
+    return result;
+}
+
+int main(int argc, char **argv)
+{
+    uint32_t iterations = argc > 1 ? strtoul(argv[1], NULL, 10) : 100000;
+    std::mt19937 random(1);
+
+    const size_t full = 3 * (sizeof(SessionData) + 1) + sizeof(SessionInfo) + 1;
+    printf("Full refresh: %zu bytes, 4 messages\n", full);
+    printf("%8s %12s %12s %12s %8s\n", "sessions", "ns/update", "bytes", "messages", "errors");
+
+    uint32_t errors = 0;
+    const size_t sizes[] = {8, 64, 128, 250};
+    for (size_t size : sizes)
+    {
+        Result result = Run(size, iterations, random);
+        printf("%8zu %12.1f %12.2f %12.2f %8u\n", size, result.nanoseconds, result.bytes, result.messages, result.errors);
+        errors += result.errors;
+    }
+    return errors == 0 ? 0 : 1;
+}
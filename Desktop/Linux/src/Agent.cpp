@@ -0,0 +1,226 @@
+#include "Agent.h"
+#include "Log.h"
+
+#include <algorithm>
+#include <string.h>
+
+static uint8_t FindDefaultIndex(const std::vector<Session> &sessions)
+{
+    for (size_t i = 0; i < sessions.size(); i++)
+    {
+        if (sessions[i].isDefault)
+            return i;
+    }
+    return 0;
+}
+
+Agent::Agent(CommunicationService &communication, AudioBackend &audio, const AgentSettings &settings)
+    : m_Communication(communication), m_Audio(audio), m_Settings(settings), m_HasPreviouslyConnected(false)
+{
+    m_Device.info.mode = m_Settings.startupMode;
+
+    m_Communication.OnDeviceConnected = [this]() { OnDeviceConnected(); };
+    m_Communication.OnMessageReceived = [this](Command command, const uint8_t *payload, uint8_t length) { OnMessageReceived(command, payload, length); };
+
+    m_Audio.OnDefaultChanged = [this](int id, DisplayMode list) { OnDefaultChanged(id, list); };
+    m_Audio.OnVolumeChanged = [this](int, int, bool) { UpdateSessions(-1); };
+    m_Audio.OnSessionCreated = [this](int id, DisplayMode list) { OnSessionCreated(id, list); };
+    m_Audio.OnSessionRemoved = [this](int id, DisplayMode list) { OnSessionRemoved(id, list); };
+}
+
+int Agent::IndexToId(uint8_t index) const
+{
+    return index < m_Sessions.size() ? m_Sessions[index].id : -1;
+}
+
+void Agent::GetSessionCounts(uint8_t counts[3])
+{
+    int output, input, application;
+    m_Audio.GetSessionCounts(output, input, application);
+    // Capped before they are narrowed, the device only gets the first SESSIONS_MAX of each list.
+    counts[0] = std::min<int>(output, SESSIONS_MAX);
+    counts[1] = std::min<int>(input, SESSIONS_MAX);
+    counts[2] = std::min<int>(application, SESSIONS_MAX);
+}
+
+void Agent::Send(void)
+{
+    if (m_Communication.IsConnected())
+        m_Communication.SendMessages(m_Batch);
+    m_Batch.Clear();
+}
+
+void Agent::SendPeakLevels(void)
+{
+    if (!m_Communication.IsConnected())
+        return;
+
+    PeakLevels levels;
+    for (uint8_t i = 0; i < SessionIndex::INDEX_MAX; i++)
+    {
+        int id = IndexToId(m_Device.sessions[i].data.id);
+        int peak = id >= 0 ? m_Audio.GetPeak(id) : 0;
+        levels.Set((SessionIndex)i, (peak * 15 + 50) / 100);
+    }
+
+    static const PeakLevels silence;
+    bool silent = memcmp(&levels, &silence, sizeof(PeakLevels)) == 0;
+    if (silent && memcmp(&m_PeakLevels, &levels, sizeof(PeakLevels)) == 0)
+        return;
+    m_PeakLevels = levels;
+    // Queued peaks are replaced, not added, so they never hold back control messages.
+    m_Communication.SendMessage(Command::PEAK_LEVELS, levels);
+}
+
+//---------------------------------------------------------
+// Audio events
+//---------------------------------------------------------
+void Agent::OnDefaultChanged(int, DisplayMode)
+{
+    UpdateSessions(-1);
+}
+
+void Agent::OnSessionCreated(int id, DisplayMode list)
+{
+    DisplayMode mode = m_Device.info.mode;
+    bool focus = m_Settings.displayNewSession && mode != DisplayMode::MODE_GAME && SessionListForMode(mode) == list;
+    UpdateSessions(focus ? id : -1);
+}
+
+void Agent::OnSessionRemoved(int, DisplayMode)
+{
+    UpdateSessions(-1);
+}
+
+void Agent::UpdateSessions(int focusId)
+{
+    std::vector<Session> sessions;
+    m_Audio.GetSessions(m_Device.info.mode, sessions);
+    // Do we still have sessions left? If not move on to the next mode that has some.
+    if (sessions.empty())
+    {
+        DisplayMode mode = m_Device.info.mode;
+        for (uint8_t tries = 1; sessions.empty() && tries < DisplayMode::MODE_MAX; tries++)
+        {
+            mode = (DisplayMode)((mode + 1) % DisplayMode::MODE_MAX);
+            if (mode == DisplayMode::MODE_SPLASH)
+                mode = DisplayMode::MODE_OUTPUT;
+            m_Audio.GetSessions(mode, sessions);
+        }
+        if (!sessions.empty())
+        {
+            ShowMode(mode);
+            return;
+        }
+    }
+
+    uint8_t counts[3];
+    GetSessionCounts(counts);
+    SessionDiff::Update(m_Device, m_Sessions, sessions, counts, focusId, m_Batch);
+    m_Sessions.swap(sessions);
+    Send();
+}
+
+void Agent::ShowMode(DisplayMode mode)
+{
+    m_Audio.GetSessions(mode, m_Sessions);
+    SessionInfo target = m_Device.info;
+    target.mode = mode;
+    target.current = FindDefaultIndex(m_Sessions);
+    GetSessionCounts(target.sessions);
+    SessionDiff::Flush(m_Device, target, m_Sessions, m_Batch);
+    Send();
+}
+
+//---------------------------------------------------------
+// Communication events
+//---------------------------------------------------------
+void Agent::OnDeviceConnected(void)
+{
+    m_Communication.SendMessage(Command::SETTINGS, m_Settings.device);
+    m_Communication.SendMessage(Command::MODE_STATES, m_ModeStates);
+
+    // Whatever the device shows, it didn't get it from us.
+    SessionInfo target = m_Device.info;
+    m_Device.Invalidate();
+    if (!m_HasPreviouslyConnected)
+    {
+        ShowMode(m_Settings.startupMode);
+    }
+    else
+    {
+        m_Audio.GetSessions(target.mode, m_Sessions);
+        GetSessionCounts(target.sessions);
+        SessionDiff::Flush(m_Device, target, m_Sessions, m_Batch);
+        Send();
+    }
+
+    m_HasPreviouslyConnected = true;
+}
+
+void Agent::OnMessageReceived(Command command, const uint8_t *payload, uint8_t length)
+{
+    if (command == Command::VOLUME_CURR_CHANGE || command == Command::VOLUME_ALT_CHANGE)
+    {
+        // isDefault, Volume, or isMuted changed for id (index)
+        const VolumeData &volume = *Protocol::View<VolumeData>(payload);
+        int sessionId = IndexToId(volume.id);
+        if (sessionId < 0)
+            return;
+
+        SessionData &session = m_Device.sessions[command - Command::VOLUME_CURR_CHANGE];
+        bool isDefault = session.data.isDefault;
+        session.data = volume;
+        if (volume.isDefault && !isDefault)
+        {
+            // The device already cleared the flag on its other slots.
+            for (SessionData &other : m_Device.sessions)
+                other.data.isDefault = &other == &session;
+        }
+
+        // The backend echoes the change, the diff then finds the device already up to date.
+        m_Audio.SetItemVolume(sessionId, volume.volume, volume.isMuted);
+        if (volume.isDefault && !isDefault)
+            m_Audio.SetDefaultEndpoint(sessionId);
+    }
+    else if (command == Command::SESSION_INFO)
+    {
+        // current, or mode
+        const SessionInfo &info = *Protocol::View<SessionInfo>(payload);
+        bool isNewMode = info.mode != m_Device.info.mode;
+        m_Device.OnDeviceSessionInfo(info);
+        if (isNewMode)
+            ShowMode(info.mode);
+        else
+        {
+            // Only the slot the device scrolled into is missing.
+            SessionDiff::Flush(m_Device, m_Device.info, m_Sessions, m_Batch);
+            Send();
+        }
+    }
+    else if (command == Command::ALTERNATE_SESSION)
+    {
+        // This comes from game mode and tells us what it selected.
+        m_Device.sessions[SessionIndex::INDEX_ALTERNATE] = *Protocol::View<SessionData>(payload);
+    }
+    else if (command == Command::MODE_STATES)
+    {
+        m_ModeStates = *Protocol::View<ModeStates>(payload);
+    }
+    else if (command == Command::STATS)
+    {
+        const LinkStats &stats = *Protocol::View<LinkStats>(payload);
+        Log::Info("Device link: read %u frames (%u bytes), wrote %u frames (%u bytes), %u size errors, %u unknown commands, %u overflows",
+                  stats.framesRead, stats.bytesRead, stats.framesWritten, stats.bytesWritten, stats.sizeErrors, stats.unknownCommands, stats.overflows);
+    }
+    else if (command == Command::DIAGNOSTICS)
+    {
+        const Diagnostics &diagnostics = *Protocol::View<Diagnostics>(payload);
+        Log::Info("Device diagnostics: %u invalid encoder transitions, %u missed timer ticks, timer up to %u us late, pixels show up to %u us, %u input overflows",
+                  diagnostics.encoderInvalid, diagnostics.timerMissed, diagnostics.timerLateMax, diagnostics.pixelsShowMax, diagnostics.inputOverflows);
+    }
+    else if (command == Command::PROBE)
+    {
+        Log::Debug("Unsolicited %d, %u bytes", command, length);
+    }
+}
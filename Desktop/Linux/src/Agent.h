@@ -0,0 +1,68 @@
+#pragma once
+//********************************************************
+// PROJECT: MAXMIX
+//
+// DECRIPTION:
+// Device state tracking for the Linux agent, port of the desktop
+// MainViewModel. Mirrors what the device shows (mode, current
+// index and the sessions around it) and keeps it in sync with
+// the audio backend in both directions. Changes are sent through
+// SessionDiff so only what the device doesn't have goes out.
+//********************************************************
+#include <vector>
+
+#include "AudioBackend.h"
+#include "CommunicationService.h"
+#include "SessionDiff.h"
+
+struct AgentSettings
+{
+    DeviceSettings device;
+    DisplayMode startupMode;
+    // Jump to sessions as they are created, except in game mode.
+    bool displayNewSession;
+
+    AgentSettings() : device(), startupMode(DisplayMode::MODE_OUTPUT), displayNewSession(true) {}
+};
+
+class Agent
+{
+public:
+    Agent(CommunicationService &communication, AudioBackend &audio, const AgentSettings &settings);
+
+    // Streams the audio peaks of the sessions on the device, call at up to 30 Hz.
+    // Silence is only sent once, the device falls back to the volume ring without updates.
+    void SendPeakLevels(void);
+
+private:
+    // Audio events
+    void OnDefaultChanged(int id, DisplayMode list);
+    void OnSessionCreated(int id, DisplayMode list);
+    void OnSessionRemoved(int id, DisplayMode list);
+    // Diffs the backend state against the device, focusId is shown if >= 0.
+    void UpdateSessions(int focusId);
+
+    // Communication events
+    void OnDeviceConnected(void);
+    void OnMessageReceived(Command command, const uint8_t *payload, uint8_t length);
+
+    void GetSessionCounts(uint8_t counts[3]);
+    // Switches to mode and shows its default session.
+    void ShowMode(DisplayMode mode);
+    void Send(void);
+    // \returns the session id shown at index on the device, or -1
+    int IndexToId(uint8_t index) const;
+
+    CommunicationService &m_Communication;
+    AudioBackend &m_Audio;
+    AgentSettings m_Settings;
+
+    // Device state tracking
+    DeviceView m_Device;
+    ModeStates m_ModeStates;
+    // Sessions of the current mode as last sent, the index is the session id on the device.
+    std::vector<Session> m_Sessions;
+    MessageBatch m_Batch;
+    bool m_HasPreviouslyConnected;
+    PeakLevels m_PeakLevels;
+};
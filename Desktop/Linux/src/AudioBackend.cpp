@@ -0,0 +1,14 @@
+#include "AudioBackend.h"
+#include "MockAudioBackend.h"
+
+AudioBackend *CreateAudioBackend(const std::string &name, const std::string &argument)
+{
+    if (name == "mock")
+        return new MockAudioBackend(argument);
+    return NULL;
+}
+
+const char *GetAudioBackendNames(void)
+{
+    return "mock";
+}
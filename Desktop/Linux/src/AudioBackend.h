@@ -0,0 +1,62 @@
+#pragma once
+//********************************************************
+// PROJECT: MAXMIX
+//
+// DECRIPTION:
+// Audio session source for the agent, Linux counterpart of the
+// desktop IAudioSessionService. Backends run on the agent's
+// EventLoop and report changes through the On* callbacks.
+//********************************************************
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "EventLoop.h"
+#include "Protocol/Protocol.h"
+
+struct Session
+{
+    int id;
+    std::string name;
+    bool isDefault;
+    int volume; // 0-100
+    bool isMuted;
+
+    Session() : id(0), isDefault(false), volume(0), isMuted(false) {}
+};
+
+// Which list a device or application belongs to, MODE_GAME shares the application list.
+inline DisplayMode SessionListForMode(DisplayMode mode)
+{
+    return mode == DisplayMode::MODE_GAME ? DisplayMode::MODE_APPLICATION : mode;
+}
+
+class AudioBackend
+{
+public:
+    virtual ~AudioBackend() {}
+
+    virtual bool Start(EventLoop &loop) = 0;
+    virtual void Stop(void) = 0;
+
+    virtual void SetItemVolume(int id, int volume, bool isMuted) = 0;
+    virtual void SetDefaultEndpoint(int id) = 0;
+    // Sessions of a mode ordered by id, the order the device scrolls through them.
+    virtual void GetSessions(DisplayMode mode, std::vector<Session> &sessions) = 0;
+    virtual void GetSessionCounts(int &output, int &input, int &application) = 0;
+    // Current audio peak of a session, 0-100. Backends without meters report silence.
+    virtual int GetPeak(int id) { (void)id; return 0; }
+
+    // Called once the backend is ready to answer GetSessions.
+    std::function<void()> OnServiceStarted;
+    // list is MODE_OUTPUT, MODE_INPUT or MODE_APPLICATION
+    std::function<void(int id, DisplayMode list)> OnDefaultChanged;
+    std::function<void(int id, DisplayMode list)> OnSessionCreated;
+    std::function<void(int id, DisplayMode list)> OnSessionRemoved;
+    std::function<void(int id, int volume, bool isMuted)> OnVolumeChanged;
+};
+
+// \returns the backend registered under name or NULL, argument is backend specific.
+AudioBackend *CreateAudioBackend(const std::string &name, const std::string &argument);
+// Space separated list of backend names for the usage text.
+const char *GetAudioBackendNames(void);
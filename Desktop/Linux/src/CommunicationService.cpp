@@ -0,0 +1,368 @@
+#include "CommunicationService.h"
+#include "FirmwareVersions.h"
+#include "Log.h"
+#include "SerialPort.h"
+
+#include <errno.h>
+#include <string.h>
+#include <sys/epoll.h>
+#include <unistd.h>
+
+static const uint32_t k_BaudRate = 76800;
+static const uint64_t k_DeviceTimeout = 5000000;   // us
+static const uint64_t k_DeviceReconnect = 1000000; // us
+static const uint32_t k_ReconnectInterval = 1000;  // ms
+// The Nano resets when the port is opened, keep asking for TEST until its bootloader is done.
+static const uint32_t k_HandshakeInterval = 100; // ms
+static const uint8_t k_HandshakeAttempts = 25;
+// Firmware SERIAL_RX_BUFFER_SIZE is 64 and the ring keeps a slot free, one more
+// is left so a full window doesn't trip the device overflow counter.
+static const size_t k_DeviceWindow = 62;
+
+CommunicationService::CommunicationService(EventLoop &loop, const std::string &port)
+    : m_Loop(loop), m_Port(port), m_Candidate(0), m_Fd(-1), m_HandshakeAttempts(0), m_Decoder(Protocol::TO_HOST),
+      m_InFlightBytes(0), m_Started(false), m_DeviceConnected(false), m_LastMessageRead(0), m_LastMessageWrite(0), m_Stats(),
+      m_ConnectTimer(loop, [this]() { Connect(); }),
+      m_HandshakeTimer(loop, [this]() { OnHandshakeTimeout(); }),
+      m_DeadlineTimer(loop, [this]() { OnDeadline(); })
+{
+}
+
+CommunicationService::~CommunicationService()
+{
+    ClosePort();
+}
+
+void CommunicationService::Start(void)
+{
+    m_Started = true;
+    Connect();
+}
+
+void CommunicationService::Stop(void)
+{
+    m_Started = false;
+    m_ConnectTimer.Stop();
+    if (m_DeviceConnected)
+        Disconnect("stopped");
+    ClosePort();
+}
+
+//---------------------------------------------------------
+// Connection
+//---------------------------------------------------------
+void CommunicationService::Connect(void)
+{
+    if (!m_Started || m_Fd >= 0)
+        return;
+
+    m_Candidates.clear();
+    if (m_Port.empty())
+        m_Candidates = SerialPort::GetPortNames();
+    else
+        m_Candidates.push_back(m_Port);
+    m_Candidate = 0;
+    TryNextPort();
+}
+
+void CommunicationService::TryNextPort(void)
+{
+    ClosePort();
+    while (m_Candidate < m_Candidates.size())
+    {
+        const std::string &name = m_Candidates[m_Candidate++];
+        m_Fd = SerialPort::Open(name.c_str(), k_BaudRate);
+        if (m_Fd < 0)
+            continue;
+
+        Log::Debug("Connect\t%s", name.c_str());
+        SerialPort::Flush(m_Fd);
+        m_Loop.Add(m_Fd, EPOLLIN, [this](uint32_t events) { OnPortEvent(events); });
+        m_Decoder.Reset();
+        m_Pending.clear();
+        m_HandshakeAttempts = 0;
+        OnHandshakeTimeout();
+        return;
+    }
+
+    // Nothing answered, try again later.
+    m_ConnectTimer.Start(k_ReconnectInterval);
+}
+
+void CommunicationService::OnHandshakeTimeout(void)
+{
+    if (m_HandshakeAttempts++ >= k_HandshakeAttempts)
+    {
+        Log::Debug("Connect\tno reply from %s", m_Candidates[m_Candidate - 1].c_str());
+        TryNextPort();
+        return;
+    }
+
+    Frame frame;
+    frame.command = Command::TEST;
+    frame.length = Protocol::Encode(Command::TEST, frame.data);
+    WriteFrame(frame);
+    m_HandshakeTimer.Start(k_HandshakeInterval);
+}
+
+void CommunicationService::Disconnect(const char *reason)
+{
+    Log::Info("Device disconnected: %s", reason);
+    m_DeviceConnected = false;
+    ClosePort();
+    if (OnDeviceDisconnected)
+        OnDeviceDisconnected();
+    if (m_Started)
+        m_ConnectTimer.Start(k_ReconnectInterval);
+}
+
+void CommunicationService::ClosePort(void)
+{
+    m_HandshakeTimer.Stop();
+    m_DeadlineTimer.Stop();
+    if (m_Fd < 0)
+        return;
+
+    m_Loop.Remove(m_Fd);
+    SerialPort::Close(m_Fd);
+    m_Fd = -1;
+}
+
+//---------------------------------------------------------
+// Reading
+//---------------------------------------------------------
+void CommunicationService::OnPortEvent(uint32_t events)
+{
+    int fd = m_Fd;
+    if (events & EPOLLIN)
+        Read();
+    // Read may have closed the port or moved on to the next one.
+    if (m_Fd != fd)
+        return;
+
+    if (events & EPOLLOUT)
+        FlushPending();
+    if (events & (EPOLLHUP | EPOLLERR))
+    {
+        if (m_DeviceConnected)
+            Disconnect("port closed");
+        else
+            TryNextPort();
+    }
+}
+
+void CommunicationService::Read(void)
+{
+    uint8_t buffer[256];
+    int fd = m_Fd;
+    while (m_Fd == fd)
+    {
+        ssize_t count = read(m_Fd, buffer, sizeof(buffer));
+        if (count <= 0)
+        {
+            if (count < 0 && errno != EAGAIN && errno != EINTR)
+                Disconnect(strerror(errno));
+            return;
+        }
+
+        m_Stats.readBytes += count;
+        uint16_t errors = m_Decoder.GetErrors();
+        const uint8_t *data = buffer;
+        while (count > 0 && m_Fd == fd)
+        {
+            bool ready;
+            size_t used = m_Decoder.Push(data, count, ready);
+            data += used;
+            count -= used;
+            if (ready)
+                OnFrame();
+        }
+        m_Stats.errorCount += (uint16_t)(m_Decoder.GetErrors() - errors);
+    }
+}
+
+void CommunicationService::OnFrame(void)
+{
+    Command command = m_Decoder.GetCommand();
+    m_Stats.readCount++;
+
+    if (!m_DeviceConnected)
+    {
+        // Anything but the TEST reply is left over from a previous session.
+        if (command != Command::TEST)
+            return;
+
+        const char *firmware = m_Decoder.GetLine();
+        Log::Debug("Connect\tTEST\t%s", firmware);
+        if (!FirmwareVersions::IsCompatible(firmware))
+        {
+            Log::Error("Incompatible Firmware: '%s'", firmware);
+            if (OnFirmwareIncompatible)
+                OnFirmwareIncompatible(firmware);
+            TryNextPort();
+            return;
+        }
+
+        Log::Info("Device connected on %s, firmware %s", m_Candidates[m_Candidate - 1].c_str(), firmware);
+        m_HandshakeTimer.Stop();
+        m_DeviceConnected = true;
+        // The device answers the handshake TEST with an OK, wait for it.
+        m_InFlight.assign(1, 1);
+        m_InFlightBytes = 1;
+        m_LastMessageRead = NowMicros();
+        ScheduleDeadline();
+        if (OnDeviceConnected)
+            OnDeviceConnected();
+        return;
+    }
+
+    m_LastMessageRead = NowMicros();
+    switch (command)
+    {
+    case Command::TEST:
+        Log::Debug("Read\tTEST\t%s", m_Decoder.GetLine());
+        m_LastMessageWrite = m_LastMessageRead;
+        break;
+    case Command::OK:
+        Log::Debug("Read\tOK");
+        // The device replies OK to every frame, in order.
+        if (!m_InFlight.empty())
+        {
+            m_InFlightBytes -= m_InFlight.front();
+            m_InFlight.pop_front();
+        }
+        Write();
+        break;
+    case Command::ERROR:
+    case Command::NONE:
+    case Command::DEBUG:
+        m_Stats.errorCount++;
+        break;
+    default:
+        Log::Debug("Read\t%d\t%u bytes", command, m_Decoder.GetLength());
+        if (OnMessageReceived)
+            OnMessageReceived(command, m_Decoder.GetPayload(), m_Decoder.GetLength());
+        break;
+    }
+    ScheduleDeadline();
+}
+
+//---------------------------------------------------------
+// Writing
+//---------------------------------------------------------
+void CommunicationService::SendMessage(Command command, const void *payload, uint8_t length)
+{
+    Enqueue(command, payload, length);
+    Write();
+}
+
+void CommunicationService::SendMessages(const MessageBatch &batch)
+{
+    for (uint8_t i = 0; i < batch.count; i++)
+        Enqueue(batch.messages[i].command, batch.messages[i].payload, batch.messages[i].length);
+    Write();
+}
+
+void CommunicationService::Enqueue(Command command, const void *payload, uint8_t length)
+{
+    for (auto it = m_MessageQueue.begin(); it != m_MessageQueue.end(); ++it)
+    {
+        if (it->command == command)
+        {
+            m_MessageQueue.erase(it);
+            break;
+        }
+    }
+
+    Frame frame;
+    frame.command = command;
+    frame.length = Protocol::Encode(command, payload, length, frame.data);
+    m_MessageQueue.push_back(frame);
+}
+
+void CommunicationService::Write(void)
+{
+    if (!m_DeviceConnected || m_MessageQueue.empty())
+        return;
+
+    while (!m_MessageQueue.empty() && m_InFlightBytes + m_MessageQueue.front().length <= k_DeviceWindow)
+    {
+        WriteFrame(m_MessageQueue.front());
+        m_MessageQueue.pop_front();
+    }
+    ScheduleDeadline();
+}
+
+void CommunicationService::WriteFrame(const Frame &frame)
+{
+    Log::Debug("Write\t%d\t%u bytes", frame.command, frame.length - 1);
+    m_Stats.writeCount++;
+    m_Stats.writeBytes += frame.length;
+    m_LastMessageWrite = NowMicros();
+    if (m_DeviceConnected)
+    {
+        m_InFlight.push_back(frame.length);
+        m_InFlightBytes += frame.length;
+    }
+
+    // Consecutive frames are sent with a single write.
+    bool flush = m_Pending.empty();
+    m_Pending.insert(m_Pending.end(), frame.data, frame.data + frame.length);
+    if (flush)
+        m_Loop.Modify(m_Fd, EPOLLIN | EPOLLOUT);
+}
+
+void CommunicationService::FlushPending(void)
+{
+    while (!m_Pending.empty())
+    {
+        ssize_t count = write(m_Fd, m_Pending.data(), m_Pending.size());
+        if (count < 0)
+        {
+            if (errno == EINTR)
+                continue;
+            if (errno != EAGAIN)
+                m_Stats.errorCount++;
+            break;
+        }
+        m_Pending.erase(m_Pending.begin(), m_Pending.begin() + count);
+    }
+    m_Loop.Modify(m_Fd, m_Pending.empty() ? EPOLLIN : EPOLLIN | EPOLLOUT);
+}
+
+//---------------------------------------------------------
+// Heartbeat and timeout
+//---------------------------------------------------------
+void CommunicationService::ScheduleDeadline(void)
+{
+    if (!m_DeviceConnected)
+        return;
+
+    uint64_t now = NowMicros();
+    uint64_t deadline = m_LastMessageWrite + k_DeviceReconnect;
+    if (m_LastMessageRead + k_DeviceTimeout < deadline)
+        deadline = m_LastMessageRead + k_DeviceTimeout;
+    m_DeadlineTimer.Start(deadline > now ? (uint32_t)((deadline - now + 999) / 1000) : 0);
+}
+
+void CommunicationService::OnDeadline(void)
+{
+    uint64_t now = NowMicros();
+    if (now - m_LastMessageRead >= k_DeviceTimeout)
+    {
+        Disconnect("timeout");
+        return;
+    }
+
+    if (now - m_LastMessageWrite >= k_DeviceReconnect)
+    {
+        // Send OK test even if we think the device is not ready, anything unacknowledged by now was lost.
+        Frame frame;
+        frame.command = Command::OK;
+        frame.length = Protocol::Encode(Command::OK, frame.data);
+        m_InFlight.clear();
+        m_InFlightBytes = 0;
+        WriteFrame(frame);
+    }
+    ScheduleDeadline();
+}
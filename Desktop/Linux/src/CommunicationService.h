@@ -0,0 +1,114 @@
+#pragma once
+//********************************************************
+// PROJECT: MAXMIX
+//
+// DECRIPTION:
+// Device link for the Linux agent, same behaviour as the desktop
+// CommunicationService: TEST handshake with firmware version check,
+// newer messages replace queued ones with the same command, OK
+// heartbeat every second and disconnect after 5 seconds of silence.
+// Instead of one message per OK, frames are written back to back
+// as long as all unacknowledged ones fit in the device receive
+// buffer, so a batch goes out in one write.
+// Unlike the desktop version nothing is polled, reads, writes and
+// timeouts are all driven by the EventLoop.
+//********************************************************
+#include <stdint.h>
+#include <deque>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "EventLoop.h"
+#include "Protocol/Protocol.h"
+#include "SessionDiff.h"
+
+class CommunicationService
+{
+public:
+    struct Stats
+    {
+        uint32_t readCount;
+        uint32_t readBytes;
+        uint32_t writeCount;
+        uint32_t writeBytes;
+        uint32_t errorCount;
+    };
+
+    // If port is empty every USB serial device is tried in turn.
+    CommunicationService(EventLoop &loop, const std::string &port);
+    ~CommunicationService();
+
+    void Start(void);
+    void Stop(void);
+
+    void SendMessage(Command command, const void *payload, uint8_t length);
+    template <typename T>
+    void SendMessage(Command command, const T &message)
+    {
+        SendMessage(command, &message, sizeof(T));
+    }
+    void SendMessage(Command command)
+    {
+        SendMessage(command, NULL, 0);
+    }
+    void SendMessages(const MessageBatch &batch);
+
+    bool IsConnected(void) const { return m_DeviceConnected; }
+    const Stats &GetStats(void) const { return m_Stats; }
+
+    std::function<void()> OnDeviceConnected;
+    std::function<void()> OnDeviceDisconnected;
+    std::function<void(const char *firmware)> OnFirmwareIncompatible;
+    std::function<void(Command command, const uint8_t *payload, uint8_t length)> OnMessageReceived;
+
+private:
+    struct Frame
+    {
+        Command command;
+        uint8_t length;
+        uint8_t data[Protocol::FRAME_MAX];
+    };
+
+    void Enqueue(Command command, const void *payload, uint8_t length);
+    void Connect(void);
+    void TryNextPort(void);
+    void OnHandshakeTimeout(void);
+    void Disconnect(const char *reason);
+    void ClosePort(void);
+
+    void OnPortEvent(uint32_t events);
+    void Read(void);
+    void OnFrame(void);
+    void Write(void);
+    void WriteFrame(const Frame &frame);
+    void FlushPending(void);
+    void ScheduleDeadline(void);
+    void OnDeadline(void);
+
+    EventLoop &m_Loop;
+    std::string m_Port;
+    std::vector<std::string> m_Candidates;
+    size_t m_Candidate;
+    int m_Fd;
+    uint8_t m_HandshakeAttempts;
+
+    Protocol::Decoder m_Decoder;
+    // Holds one entry per command at most.
+    std::deque<Frame> m_MessageQueue;
+    // Sizes of the frames written but not acknowledged yet, oldest first.
+    std::deque<uint8_t> m_InFlight;
+    size_t m_InFlightBytes;
+    // Bytes the driver did not accept yet, only non-empty when the tty buffer is full.
+    std::vector<uint8_t> m_Pending;
+
+    bool m_Started;
+    bool m_DeviceConnected;
+    uint64_t m_LastMessageRead;
+    uint64_t m_LastMessageWrite;
+    Stats m_Stats;
+
+    Timer m_ConnectTimer;
+    Timer m_HandshakeTimer;
+    Timer m_DeadlineTimer;
+};
@@ -0,0 +1,148 @@
+#include "EventLoop.h"
+#include "Log.h"
+
+#include <errno.h>
+#include <signal.h>
+#include <string.h>
+#include <sys/epoll.h>
+#include <sys/signalfd.h>
+#include <sys/timerfd.h>
+#include <time.h>
+#include <unistd.h>
+
+static const int k_MaxEvents = 16;
+
+uint64_t NowMicros(void)
+{
+    timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000 + now.tv_nsec / 1000;
+}
+
+//********************************************************
+// *** EventLoop
+//********************************************************
+EventLoop::EventLoop() : m_EpollFd(epoll_create1(EPOLL_CLOEXEC)), m_SignalFd(-1), m_Running(false)
+{
+    sigset_t signals;
+    sigemptyset(&signals);
+    sigaddset(&signals, SIGINT);
+    sigaddset(&signals, SIGTERM);
+    sigprocmask(SIG_BLOCK, &signals, NULL);
+    m_SignalFd = signalfd(-1, &signals, SFD_NONBLOCK | SFD_CLOEXEC);
+    Add(m_SignalFd, EPOLLIN, [this](uint32_t) {
+        signalfd_siginfo info;
+        while (read(m_SignalFd, &info, sizeof(info)) == sizeof(info))
+            Log::Info("Received signal %u, stopping", info.ssi_signo);
+        Stop();
+    });
+}
+
+EventLoop::~EventLoop()
+{
+    close(m_SignalFd);
+    close(m_EpollFd);
+}
+
+bool EventLoop::Add(int fd, uint32_t events, Handler handler)
+{
+    epoll_event event = {};
+    event.events = events;
+    event.data.fd = fd;
+    if (epoll_ctl(m_EpollFd, EPOLL_CTL_ADD, fd, &event) != 0)
+    {
+        Log::Error("epoll add %d: %s", fd, strerror(errno));
+        return false;
+    }
+    m_Handlers[fd] = handler;
+    return true;
+}
+
+bool EventLoop::Modify(int fd, uint32_t events)
+{
+    epoll_event event = {};
+    event.events = events;
+    event.data.fd = fd;
+    return epoll_ctl(m_EpollFd, EPOLL_CTL_MOD, fd, &event) == 0;
+}
+
+void EventLoop::Remove(int fd)
+{
+    epoll_ctl(m_EpollFd, EPOLL_CTL_DEL, fd, NULL);
+    m_Handlers.erase(fd);
+}
+
+void EventLoop::Run(void)
+{
+    epoll_event events[k_MaxEvents];
+    m_Running = true;
+    while (m_Running)
+    {
+        int count = epoll_wait(m_EpollFd, events, k_MaxEvents, -1);
+        if (count < 0)
+        {
+            if (errno == EINTR)
+                continue;
+            Log::Error("epoll_wait: %s", strerror(errno));
+            break;
+        }
+
+        for (int i = 0; i < count && m_Running; i++)
+        {
+            // A previous handler in this batch may have removed the fd, look it up every time.
+            auto handler = m_Handlers.find(events[i].data.fd);
+            if (handler != m_Handlers.end())
+            {
+                // Copy, the handler is allowed to remove itself.
+                Handler callback = handler->second;
+                callback(events[i].events);
+            }
+        }
+    }
+}
+
+void EventLoop::Stop(void)
+{
+    m_Running = false;
+}
+
+//********************************************************
+// *** Timer
+//********************************************************
+Timer::Timer(EventLoop &loop, Callback callback)
+    : m_Loop(loop), m_Callback(callback), m_Fd(timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC)), m_Active(false), m_Periodic(false)
+{
+    m_Loop.Add(m_Fd, EPOLLIN, [this](uint32_t) {
+        uint64_t expirations;
+        if (read(m_Fd, &expirations, sizeof(expirations)) != sizeof(expirations))
+            return;
+        m_Active = m_Periodic;
+        m_Callback();
+    });
+}
+
+Timer::~Timer()
+{
+    m_Loop.Remove(m_Fd);
+    close(m_Fd);
+}
+
+void Timer::Start(uint32_t milliseconds, bool periodic)
+{
+    itimerspec spec = {};
+    // A zero it_value disarms the timer, round up to the smallest delay instead.
+    spec.it_value.tv_sec = milliseconds / 1000;
+    spec.it_value.tv_nsec = milliseconds % 1000 * 1000000L + (milliseconds == 0 ? 1 : 0);
+    if (periodic)
+        spec.it_interval = spec.it_value;
+    timerfd_settime(m_Fd, 0, &spec, NULL);
+    m_Active = true;
+    m_Periodic = periodic;
+}
+
+void Timer::Stop(void)
+{
+    itimerspec spec = {};
+    timerfd_settime(m_Fd, 0, &spec, NULL);
+    m_Active = false;
+}
@@ -0,0 +1,63 @@
+#pragma once
+//********************************************************
+// PROJECT: MAXMIX
+//
+// DECRIPTION:
+// Single threaded epoll loop. Every source of work in the agent
+// (serial port, timers, signals, audio backends) is a file
+// descriptor registered here, the loop sleeps in epoll_wait
+// until one of them is ready so nothing is ever polled.
+//********************************************************
+#include <stdint.h>
+#include <functional>
+#include <unordered_map>
+
+class EventLoop
+{
+public:
+    typedef std::function<void(uint32_t events)> Handler;
+
+    EventLoop();
+    ~EventLoop();
+
+    bool Add(int fd, uint32_t events, Handler handler);
+    bool Modify(int fd, uint32_t events);
+    void Remove(int fd);
+
+    // Runs until Stop is called or SIGINT/SIGTERM is received.
+    void Run(void);
+    void Stop(void);
+
+private:
+    int m_EpollFd;
+    int m_SignalFd;
+    bool m_Running;
+    std::unordered_map<int, Handler> m_Handlers;
+};
+
+// One shot or periodic timer backed by a timerfd.
+class Timer
+{
+public:
+    typedef std::function<void()> Callback;
+
+    Timer(EventLoop &loop, Callback callback);
+    ~Timer();
+
+    void Start(uint32_t milliseconds, bool periodic = false);
+    void Stop(void);
+    bool IsActive(void) const { return m_Active; }
+
+private:
+    Timer(const Timer &) = delete;
+    Timer &operator=(const Timer &) = delete;
+
+    EventLoop &m_Loop;
+    Callback m_Callback;
+    int m_Fd;
+    bool m_Active;
+    bool m_Periodic;
+};
+
+// Monotonic time in microseconds, same clock as the event loop timers.
+uint64_t NowMicros(void);
@@ -0,0 +1,29 @@
+#pragma once
+//********************************************************
+// PROJECT: MAXMIX
+//
+// DECRIPTION:
+// This is the set of firmware versions that work for this agent,
+// keep in sync with Desktop/Application/MaxMix/Services/Communication/FirmwareVersions.cs
+//********************************************************
+#include <string.h>
+
+namespace FirmwareVersions
+{
+    inline bool IsCompatible(const char *version)
+    {
+        static const char *valid[] = {
+#ifndef NDEBUG
+            "0.0.0",
+#endif
+            // 1.6.0 added the lighting effects to DeviceSettings, older firmware reads a shorter SETTINGS.
+            "1.6.0"};
+
+        for (const char *item : valid)
+        {
+            if (strcmp(item, version) == 0)
+                return true;
+        }
+        return false;
+    }
+} // namespace FirmwareVersions
@@ -0,0 +1,45 @@
+#include "Log.h"
+#include "EventLoop.h"
+
+#include <stdarg.h>
+#include <stdio.h>
+
+namespace Log
+{
+    static Level s_Level = LEVEL_INFO;
+
+    static void Write(Level level, const char *format, va_list args)
+    {
+        if (level > s_Level)
+            return;
+
+        static const char *names[] = {"ERROR", "INFO", "DEBUG"};
+        uint64_t now = NowMicros();
+        fprintf(stderr, "%6lu.%06lu %-5s ", (unsigned long)(now / 1000000 % 1000000), (unsigned long)(now % 1000000), names[level]);
+        vfprintf(stderr, format, args);
+        fputc('\n', stderr);
+    }
+
+    void SetLevel(Level level)
+    {
+        s_Level = level;
+    }
+
+    bool IsEnabled(Level level)
+    {
+        return level <= s_Level;
+    }
+
+#define LOG_FUNCTION(name, level)           \
+    void name(const char *format, ...)      \
+    {                                       \
+        va_list args;                       \
+        va_start(args, format);             \
+        Write(level, format, args);         \
+        va_end(args);                       \
+    }
+
+    LOG_FUNCTION(Error, LEVEL_ERROR)
+    LOG_FUNCTION(Info, LEVEL_INFO)
+    LOG_FUNCTION(Debug, LEVEL_DEBUG)
+} // namespace Log
@@ -0,0 +1,24 @@
+#pragma once
+//********************************************************
+// PROJECT: MAXMIX
+//
+// DECRIPTION:
+// Minimal stderr logger for the host agent.
+//********************************************************
+
+namespace Log
+{
+    enum Level
+    {
+        LEVEL_ERROR,
+        LEVEL_INFO,
+        LEVEL_DEBUG
+    };
+
+    void SetLevel(Level level);
+    bool IsEnabled(Level level);
+
+    void Error(const char *format, ...) __attribute__((format(printf, 1, 2)));
+    void Info(const char *format, ...) __attribute__((format(printf, 1, 2)));
+    void Debug(const char *format, ...) __attribute__((format(printf, 1, 2)));
+} // namespace Log
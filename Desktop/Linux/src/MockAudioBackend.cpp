@@ -0,0 +1,279 @@
+#include "MockAudioBackend.h"
+#include "Log.h"
+
+#include <fstream>
+#include <sstream>
+
+static const size_t k_NoRepeat = (size_t)-1;
+
+static const char *k_DefaultScript =
+    "output 1 80 default Speakers\n"
+    "output 2 50 Headphones\n"
+    "input 10 70 default Microphone\n"
+    "app 100 100 System Sounds\n"
+    "app 101 65 Music Player\n"
+    "app 102 40 Voice Chat\n"
+    "wait 5000\n"
+    "app 103 90 Game\n"
+    "wait 5000\n"
+    "volume 101 30\n"
+    "wait 5000\n"
+    "volume 102 40 muted\n"
+    "wait 5000\n"
+    "default 2\n"
+    "wait 5000\n"
+    "remove 103\n"
+    "volume 102 40\n"
+    "default 1\n"
+    "repeat\n";
+
+MockAudioBackend::MockAudioBackend(const std::string &script) : m_Script(script), m_Line(0), m_RepeatLine(k_NoRepeat)
+{
+}
+
+bool MockAudioBackend::Load(void)
+{
+    std::stringstream text;
+    if (m_Script.empty())
+    {
+        text << k_DefaultScript;
+    }
+    else
+    {
+        std::ifstream file(m_Script);
+        if (!file)
+        {
+            Log::Error("Mock: can't open script '%s'", m_Script.c_str());
+            return false;
+        }
+        text << file.rdbuf();
+    }
+
+    std::string line;
+    while (std::getline(text, line))
+    {
+        size_t comment = line.find('#');
+        if (comment != std::string::npos)
+            line.erase(comment);
+        if (line.find_first_not_of(" \t\r") != std::string::npos)
+            m_Lines.push_back(line);
+    }
+    return true;
+}
+
+bool MockAudioBackend::Start(EventLoop &loop)
+{
+    if (!Load())
+        return false;
+
+    m_Timer.reset(new Timer(loop, [this]() { Step(true); }));
+    // Initial state, no notifications. Stops at the first wait and arms the timer.
+    m_Line = 0;
+    Step(false);
+
+    if (OnServiceStarted)
+        OnServiceStarted();
+    return true;
+}
+
+void MockAudioBackend::Stop(void)
+{
+    m_Timer.reset();
+}
+
+void MockAudioBackend::Step(bool notify)
+{
+    while (m_Line < m_Lines.size())
+    {
+        uint32_t wait = 0;
+        size_t line = m_Line++;
+        if (!Execute(line, notify, wait))
+            Log::Error("Mock: invalid script line %zu '%s'", line + 1, m_Lines[line].c_str());
+
+        if (wait > 0)
+        {
+            if (m_RepeatLine == k_NoRepeat)
+                m_RepeatLine = line;
+            m_Timer->Start(wait);
+            return;
+        }
+    }
+    Log::Info("Mock: end of script");
+}
+
+bool MockAudioBackend::Execute(size_t index, bool notify, uint32_t &wait)
+{
+    std::istringstream line(m_Lines[index]);
+    std::string command;
+    line >> command;
+
+    if (command == "repeat")
+    {
+        // Without a wait to go back to the script would spin forever.
+        m_Line = m_RepeatLine != k_NoRepeat ? m_RepeatLine : m_Lines.size();
+        return true;
+    }
+
+    int value;
+    if (!(line >> value))
+        return false;
+
+    if (command == "wait")
+    {
+        wait = value > 0 ? value : 1;
+        return true;
+    }
+
+    if (command == "remove")
+    {
+        auto entry = m_Entries.find(value);
+        if (entry == m_Entries.end())
+            return false;
+        DisplayMode list = entry->second.list;
+        m_Entries.erase(entry);
+        if (notify && OnSessionRemoved)
+            OnSessionRemoved(value, list);
+        return true;
+    }
+
+    if (command == "default")
+    {
+        if (m_Entries.find(value) == m_Entries.end())
+            return false;
+        SetDefault(value, notify);
+        return true;
+    }
+
+    int volume;
+    if (!(line >> volume) || volume < 0 || volume > 100)
+        return false;
+
+    bool isMuted = false;
+    bool isDefault = false;
+    std::string word;
+    std::streampos name = line.tellg();
+    while (line >> word && (word == "muted" || word == "default"))
+    {
+        isMuted |= word == "muted";
+        isDefault |= word == "default";
+        name = line.tellg();
+    }
+
+    if (command == "volume")
+    {
+        auto entry = m_Entries.find(value);
+        if (entry == m_Entries.end())
+            return false;
+        entry->second.session.volume = volume;
+        entry->second.session.isMuted = isMuted;
+        if (notify && OnVolumeChanged)
+            OnVolumeChanged(value, volume, isMuted);
+        return true;
+    }
+
+    Entry entry;
+    if (command == "output")
+        entry.list = DisplayMode::MODE_OUTPUT;
+    else if (command == "input")
+        entry.list = DisplayMode::MODE_INPUT;
+    else if (command == "app")
+        entry.list = DisplayMode::MODE_APPLICATION;
+    else
+        return false;
+
+    if (name == std::streampos(-1))
+        return false;
+    std::string text = m_Lines[index].substr((size_t)name);
+    size_t start = text.find_first_not_of(" \t");
+    size_t end = text.find_last_not_of(" \t\r");
+    if (start == std::string::npos)
+        return false;
+
+    entry.session.id = value;
+    entry.session.name = text.substr(start, end - start + 1);
+    entry.session.volume = volume;
+    entry.session.isMuted = isMuted;
+    m_Entries[value] = entry;
+    if (notify && OnSessionCreated)
+        OnSessionCreated(value, entry.list);
+    if (isDefault && entry.list != DisplayMode::MODE_APPLICATION)
+        SetDefault(value, notify);
+    return true;
+}
+
+void MockAudioBackend::SetDefault(int id, bool notify)
+{
+    DisplayMode list = m_Entries[id].list;
+    if (list == DisplayMode::MODE_APPLICATION)
+        return;
+
+    for (auto &item : m_Entries)
+    {
+        if (item.second.list == list)
+            item.second.session.isDefault = item.first == id;
+    }
+    if (notify && OnDefaultChanged)
+        OnDefaultChanged(id, list);
+}
+
+void MockAudioBackend::SetItemVolume(int id, int volume, bool isMuted)
+{
+    auto entry = m_Entries.find(id);
+    if (entry == m_Entries.end())
+        return;
+
+    Log::Info("Mock: %s volume %d%s", entry->second.session.name.c_str(), volume, isMuted ? " muted" : "");
+    entry->second.session.volume = volume;
+    entry->second.session.isMuted = isMuted;
+    if (OnVolumeChanged)
+        OnVolumeChanged(id, volume, isMuted);
+}
+
+void MockAudioBackend::SetDefaultEndpoint(int id)
+{
+    auto entry = m_Entries.find(id);
+    if (entry == m_Entries.end())
+        return;
+
+    Log::Info("Mock: default device %s", entry->second.session.name.c_str());
+    SetDefault(id, true);
+}
+
+void MockAudioBackend::GetSessions(DisplayMode mode, std::vector<Session> &sessions)
+{
+    DisplayMode list = SessionListForMode(mode);
+    sessions.clear();
+    // std::map keeps them ordered by id.
+    for (auto &item : m_Entries)
+    {
+        if (item.second.list == list)
+            sessions.push_back(item.second.session);
+    }
+}
+
+void MockAudioBackend::GetSessionCounts(int &output, int &input, int &application)
+{
+    output = input = application = 0;
+    for (auto &item : m_Entries)
+    {
+        if (item.second.list == DisplayMode::MODE_OUTPUT)
+            output++;
+        else if (item.second.list == DisplayMode::MODE_INPUT)
+            input++;
+        else
+            application++;
+    }
+}
+
+int MockAudioBackend::GetPeak(int id)
+{
+    auto entry = m_Entries.find(id);
+    if (entry == m_Entries.end() || entry->second.session.isMuted)
+        return 0;
+
+    // A beat every half second decaying in between, with some noise on top.
+    uint32_t now = NowMicros() / 1000;
+    uint32_t noise = (now / 33 + id) * 2654435761u;
+    int peak = 100 - (now % 500) / 6 - (noise >> 28);
+    return peak * entry->second.session.volume / 100;
+}
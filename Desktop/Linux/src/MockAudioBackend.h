@@ -0,0 +1,62 @@
+#pragma once
+//********************************************************
+// PROJECT: MAXMIX
+//
+// DECRIPTION:
+// Scripted audio backend for testing the agent and the firmware
+// without a sound server. The script is a text file, one command
+// per line, '#' starts a comment:
+//
+//   output <id> <volume> [muted] [default] <name>   add an output device
+//   input  <id> <volume> [muted] [default] <name>   add an input device
+//   app    <id> <volume> [muted] <name>             add an application
+//   volume <id> <volume> [muted]                    change volume / mute
+//   default <id>                                    make a device the default
+//   remove <id>                                     remove a device or application
+//   wait <ms>                                       pause the script
+//   repeat                                          go back to the first wait
+//
+// Everything before the first wait is the initial state.
+// Volume changes made from the device are echoed back like a real
+// sound server does.
+//********************************************************
+#include <map>
+#include <memory>
+
+#include "AudioBackend.h"
+
+class MockAudioBackend : public AudioBackend
+{
+public:
+    // script is a file path, empty for the built-in script.
+    explicit MockAudioBackend(const std::string &script);
+
+    bool Start(EventLoop &loop) override;
+    void Stop(void) override;
+
+    void SetItemVolume(int id, int volume, bool isMuted) override;
+    void SetDefaultEndpoint(int id) override;
+    void GetSessions(DisplayMode mode, std::vector<Session> &sessions) override;
+    void GetSessionCounts(int &output, int &input, int &application) override;
+    int GetPeak(int id) override;
+
+private:
+    struct Entry
+    {
+        DisplayMode list;
+        Session session;
+    };
+
+    bool Load(void);
+    // Runs script lines until the next wait.
+    void Step(bool notify);
+    bool Execute(size_t line, bool notify, uint32_t &wait);
+    void SetDefault(int id, bool notify);
+
+    std::string m_Script;
+    std::vector<std::string> m_Lines;
+    size_t m_Line;
+    size_t m_RepeatLine;
+    std::map<int, Entry> m_Entries;
+    std::unique_ptr<Timer> m_Timer;
+};
@@ -0,0 +1,78 @@
+#include "SerialPort.h"
+#include "Log.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <glob.h>
+#include <string.h>
+#include <sys/ioctl.h>
+#include <unistd.h>
+// termios2 is needed for arbitrary baud rates, it can't be mixed with <termios.h>.
+#include <asm/termbits.h>
+
+namespace SerialPort
+{
+    int Open(const char *path, uint32_t baudRate)
+    {
+        int fd = open(path, O_RDWR | O_NOCTTY | O_NONBLOCK | O_CLOEXEC);
+        if (fd < 0)
+        {
+            Log::Debug("open %s: %s", path, strerror(errno));
+            return -1;
+        }
+
+        termios2 tio;
+        if (ioctl(fd, TCGETS2, &tio) != 0)
+        {
+            Log::Debug("%s is not a tty: %s", path, strerror(errno));
+            close(fd);
+            return -1;
+        }
+
+        // Equivalent of cfmakeraw, 8N1, no flow control.
+        tio.c_iflag &= ~(IGNBRK | BRKINT | PARMRK | ISTRIP | INLCR | IGNCR | ICRNL | IXON | IXOFF | IXANY);
+        tio.c_oflag &= ~OPOST;
+        tio.c_lflag &= ~(ECHO | ECHONL | ICANON | ISIG | IEXTEN);
+        tio.c_cflag &= ~(CSIZE | PARENB | CSTOPB | CRTSCTS | CBAUD);
+        tio.c_cflag |= CS8 | CREAD | CLOCAL | BOTHER;
+        tio.c_ispeed = baudRate;
+        tio.c_ospeed = baudRate;
+        tio.c_cc[VMIN] = 0;
+        tio.c_cc[VTIME] = 0;
+        if (ioctl(fd, TCSETS2, &tio) != 0)
+        {
+            Log::Debug("configure %s: %s", path, strerror(errno));
+            close(fd);
+            return -1;
+        }
+        return fd;
+    }
+
+    void Close(int fd)
+    {
+        if (fd >= 0)
+            close(fd);
+    }
+
+    void Flush(int fd)
+    {
+        ioctl(fd, TCFLSH, TCIOFLUSH);
+    }
+
+    std::vector<std::string> GetPortNames(void)
+    {
+        std::vector<std::string> names;
+        static const char *patterns[] = {"/dev/ttyUSB*", "/dev/ttyACM*"};
+        for (const char *pattern : patterns)
+        {
+            glob_t matches;
+            if (glob(pattern, 0, NULL, &matches) == 0)
+            {
+                for (size_t i = 0; i < matches.gl_pathc; i++)
+                    names.push_back(matches.gl_pathv[i]);
+            }
+            globfree(&matches);
+        }
+        return names;
+    }
+} // namespace SerialPort
@@ -0,0 +1,23 @@
+#pragma once
+//********************************************************
+// PROJECT: MAXMIX
+//
+// DECRIPTION:
+// Raw non-blocking access to a serial device (termios).
+//********************************************************
+#include <stddef.h>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+namespace SerialPort
+{
+    // Opens the device raw 8N1 at any baud rate, including the non-standard 76800.
+    // \returns the non-blocking fd or -1
+    int Open(const char *path, uint32_t baudRate);
+    void Close(int fd);
+    // Drops everything in the driver buffers, both directions.
+    void Flush(int fd);
+    // Candidate devices, USB serial adapters first.
+    std::vector<std::string> GetPortNames(void);
+} // namespace SerialPort
@@ -0,0 +1,172 @@
+#include "SessionDiff.h"
+
+#include <algorithm>
+#include <string.h>
+
+SessionData ToSessionData(const std::vector<Session> &sessions, int index)
+{
+    SessionData data;
+    const Session &session = sessions[index];
+    strncpy(data.name, session.name.c_str(), sizeof(data.name) - 1);
+    data.data.id = index;
+    data.data.isDefault = session.isDefault;
+    data.data.volume = session.volume;
+    data.data.isMuted = session.isMuted;
+    return data;
+}
+
+uint8_t GetIndexForMode(DisplayMode mode)
+{
+    if (mode == DisplayMode::MODE_INPUT)
+        return 1;
+    if (mode == DisplayMode::MODE_GAME || mode == DisplayMode::MODE_APPLICATION)
+        return 2;
+    return 0;
+}
+
+//********************************************************
+// *** DeviceView
+//********************************************************
+void DeviceView::Invalidate(void)
+{
+    // Values the device can't be showing, everything is different on the next Flush.
+    // The mode is kept, it is what the host wants to show.
+    info.current = 0xFF;
+    memset(info.sessions, 0xFF, sizeof(info.sessions));
+    for (SessionData &session : sessions)
+        memset((void *)&session, 0xFF, sizeof(session));
+}
+
+void DeviceView::OnDeviceSessionInfo(const SessionInfo &next)
+{
+    uint8_t count = info.sessions[GetIndexForMode(info.mode)];
+    if (next.mode != info.mode)
+    {
+        // The device clears the current name when it changes mode.
+        memset(sessions[SessionIndex::INDEX_CURRENT].name, 0, sizeof(sessions[SessionIndex::INDEX_CURRENT].name));
+    }
+    else if (count > 1 && next.current == (info.current + 1) % count)
+    {
+        // NextSession
+        sessions[SessionIndex::INDEX_PREVIOUS] = sessions[SessionIndex::INDEX_CURRENT];
+        sessions[SessionIndex::INDEX_CURRENT] = sessions[SessionIndex::INDEX_NEXT];
+    }
+    else if (count > 1 && next.current == (info.current + count - 1) % count)
+    {
+        // PreviousSession
+        sessions[SessionIndex::INDEX_NEXT] = sessions[SessionIndex::INDEX_CURRENT];
+        sessions[SessionIndex::INDEX_CURRENT] = sessions[SessionIndex::INDEX_PREVIOUS];
+    }
+    info = next;
+}
+
+//********************************************************
+// *** MessageBatch
+//********************************************************
+void MessageBatch::Add(Command command, const void *payload, uint8_t length)
+{
+    Message &message = messages[count++];
+    message.command = command;
+    message.length = length;
+    memcpy(message.payload, payload, length);
+}
+
+size_t MessageBatch::GetSize(void) const
+{
+    size_t size = 0;
+    for (uint8_t i = 0; i < count; i++)
+        size += messages[i].length + 1;
+    return size;
+}
+
+//********************************************************
+// *** SessionDiff
+//********************************************************
+namespace SessionDiff
+{
+    static bool CompareId(const Session &session, int id)
+    {
+        return session.id < id;
+    }
+
+    // \returns the index of id in sessions or -1, also when it is past SESSIONS_MAX
+    static int FindId(const std::vector<Session> &sessions, int id)
+    {
+        auto it = std::lower_bound(sessions.begin(), sessions.end(), id, CompareId);
+        int index = it != sessions.end() && it->id == id ? it - sessions.begin() : -1;
+        return index < (int)SESSIONS_MAX ? index : -1;
+    }
+
+    static bool IsSameVolume(const VolumeData &a, const VolumeData &b)
+    {
+        return a.id == b.id && a.isDefault == b.isDefault && a.volume == b.volume && a.isMuted == b.isMuted;
+    }
+
+    static void FlushSlot(DeviceView &device, SessionIndex slot, const SessionData &target, MessageBatch &batch)
+    {
+        SessionData &current = device.sessions[slot];
+        if (memcmp(current.name, target.name, sizeof(target.name)) != 0)
+        {
+            batch.Add((Command)(Command::CURRENT_SESSION + slot), &target, sizeof(SessionData));
+            current = target;
+        }
+        else if (!IsSameVolume(current.data, target.data))
+        {
+            batch.Add((Command)(Command::VOLUME_CURR_CHANGE + slot), &target.data, sizeof(VolumeData));
+            current.data = target.data;
+        }
+    }
+
+    uint8_t ResolveCurrent(const std::vector<Session> &previous, const std::vector<Session> &next, uint8_t current, int focusId)
+    {
+        if (next.empty())
+            return 0;
+
+        int index = focusId >= 0 ? FindId(next, focusId) : -1;
+        if (index < 0 && current < previous.size())
+            index = FindId(next, previous[current].id);
+        if (index >= 0)
+            return index;
+
+        for (size_t i = 0; i < next.size() && i < SESSIONS_MAX; i++)
+        {
+            if (next[i].isDefault)
+                return i;
+        }
+        return 0;
+    }
+
+    void Flush(DeviceView &device, const SessionInfo &target, const std::vector<Session> &sessions, MessageBatch &batch)
+    {
+        size_t count = std::min(sessions.size(), SESSIONS_MAX);
+        if (count > 0)
+        {
+            uint8_t index = target.current < count ? target.current : 0;
+            uint8_t previous = (index + count - 1) % count;
+            uint8_t next = (index + 1) % count;
+            FlushSlot(device, SessionIndex::INDEX_CURRENT, ToSessionData(sessions, index), batch);
+            FlushSlot(device, SessionIndex::INDEX_PREVIOUS, ToSessionData(sessions, previous), batch);
+            FlushSlot(device, SessionIndex::INDEX_NEXT, ToSessionData(sessions, next), batch);
+        }
+
+        SessionInfo info = target;
+        if (info.current >= count)
+            info.current = 0;
+        for (uint8_t &sessionCount : info.sessions)
+            sessionCount = std::min<size_t>(sessionCount, SESSIONS_MAX);
+        if (memcmp(&device.info, &info, sizeof(SessionInfo)) != 0)
+        {
+            batch.Add(Command::SESSION_INFO, &info, sizeof(SessionInfo));
+            device.info = info;
+        }
+    }
+
+    void Update(DeviceView &device, const std::vector<Session> &previous, const std::vector<Session> &next,
+                const uint8_t counts[3], int focusId, MessageBatch &batch)
+    {
+        SessionInfo target = device.info;
+        memcpy(target.sessions, counts, sizeof(target.sessions));
+        target.current = ResolveCurrent(previous, next, device.info.current, focusId);
+        Flush(device, target, next, batch);
+    }
+} // namespace SessionDiff
@@ -0,0 +1,83 @@
+#pragma once
+//********************************************************
+// PROJECT: MAXMIX
+//
+// DECRIPTION:
+// Computes the smallest set of messages that brings the device
+// from what it shows now to a new session list.
+// The desktop application resends SESSION_INFO and all three
+// neighbouring SessionData (105 bytes) on every change, here a
+// slot is only sent if it differs, and only its VolumeData
+// (3 bytes instead of 33) when the name did not change.
+// Pure functions over plain data, no I/O, so it can be tested
+// and benchmarked on its own.
+//********************************************************
+#include <stdint.h>
+#include <vector>
+
+#include "AudioBackend.h"
+#include "Protocol/Protocol.h"
+
+// What the device currently shows, updated as messages are sent or received.
+struct DeviceView
+{
+    SessionInfo info;
+    SessionData sessions[SessionIndex::INDEX_MAX];
+
+    // Unknown device state, the next Flush sends everything.
+    void Invalidate(void);
+
+    // Applies a SESSION_INFO sent by the device. The device rotates its own
+    // slots when it scrolls, mirror that so they are not sent again.
+    void OnDeviceSessionInfo(const SessionInfo &info);
+};
+
+// Messages are ordered: session slots first, SESSION_INFO last, so the device
+// never shows a new index with stale names.
+struct MessageBatch
+{
+    // CURRENT, PREVIOUS, NEXT and SESSION_INFO at most.
+    static const uint8_t MAX = 4;
+
+    struct Message
+    {
+        Command command;
+        uint8_t length;
+        uint8_t payload[Protocol::PAYLOAD_MAX];
+    };
+
+    uint8_t count;
+    Message messages[MAX];
+
+    MessageBatch() : count(0) {}
+
+    void Clear(void) { count = 0; }
+    void Add(Command command, const void *payload, uint8_t length);
+    // Bytes on the wire, command bytes included.
+    size_t GetSize(void) const;
+};
+
+// VolumeData::id is 7 bits, the device can only address this many sessions per mode.
+// Sessions further down a list are not shown, counts sent to the device are capped too.
+static const size_t SESSIONS_MAX = 128;
+
+// Builds the device view of sessions[index], id is the index in the list, index < SESSIONS_MAX.
+SessionData ToSessionData(const std::vector<Session> &sessions, int index);
+// Index in SessionInfo::sessions for a mode, same as the firmware.
+uint8_t GetIndexForMode(DisplayMode mode);
+
+namespace SessionDiff
+{
+    // Index to show once the list changed from previous to next. The session shown at
+    // current keeps being shown wherever it moved, if it is gone the default one is.
+    // focusId, when >= 0, is a session that should be shown instead (new sessions).
+    // Both lists must be ordered by id. Sessions past SESSIONS_MAX count as gone.
+    uint8_t ResolveCurrent(const std::vector<Session> &previous, const std::vector<Session> &next, uint8_t current, int focusId);
+
+    // Appends the messages that make the device show target and sessions around target.current, updates device to match.
+    void Flush(DeviceView &device, const SessionInfo &target, const std::vector<Session> &sessions, MessageBatch &batch);
+
+    // ResolveCurrent + Flush, target is device.info with the counts updated.
+    void Update(DeviceView &device, const std::vector<Session> &previous, const std::vector<Session> &next,
+                const uint8_t counts[3], int focusId, MessageBatch &batch);
+} // namespace SessionDiff
@@ -0,0 +1,143 @@
+//********************************************************
+// PROJECT: MAXMIX
+//
+// DECRIPTION:
+// Linux host agent. Connects to a MaxMix device and mirrors the
+// sessions of an audio backend on it, like the desktop application.
+//
+// USAGE:
+// maxmix-agent [--port PATH] [--backend NAME[:ARGUMENT]] [--mode MODE] [--effects MUTE,SPLASH,SLEEP] [--meter] [--stats SECONDS] [--verbose]
+//   --port PATH     serial device, by default every /dev/ttyUSB* and /dev/ttyACM* is tried
+//   --backend       audio backend, mock by default. mock:FILE runs a script (see MockAudioBackend.h)
+//   --mode MODE     startup mode: output, input, application or game
+//   --effects       ring lighting while muted, on the splash screen and asleep:
+//                   off, pulse, breathe, spin, rainbow or fade
+//   --meter         stream audio peaks, the ring shows them as a meter
+//   --stats SECONDS log the device link stats and diagnostics this often
+//   --verbose       log every message
+//********************************************************
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <memory>
+
+#include "Agent.h"
+#include "AudioBackend.h"
+#include "CommunicationService.h"
+#include "EventLoop.h"
+#include "Log.h"
+
+static int Usage(const char *name)
+{
+    fprintf(stderr, "usage: %s [--port PATH] [--backend NAME[:ARGUMENT]] [--mode output|input|application|game] [--effects MUTE,SPLASH,SLEEP] [--meter] [--stats SECONDS] [--verbose]\n", name);
+    fprintf(stderr, "effects: off, pulse, breathe, spin, rainbow, fade\n");
+    fprintf(stderr, "backends: %s\n", GetAudioBackendNames());
+    return 1;
+}
+
+// \returns false if value isn't three comma separated effect names
+static bool ParseEffects(const char *value, DeviceSettings &device)
+{
+    // Same order as LightingEffect.
+    static const char *names[] = {"off", "pulse", "breathe", "spin", "rainbow", "fade"};
+    LightingEffect *slots[] = {&device.muteEffect, &device.splashEffect, &device.sleepEffect};
+    for (size_t slot = 0; slot < 3; slot++)
+    {
+        size_t length = strcspn(value, ",");
+        size_t index = 0;
+        while (index < LightingEffect::EFFECT_MAX && (strlen(names[index]) != length || strncmp(names[index], value, length) != 0))
+            index++;
+        if (index == LightingEffect::EFFECT_MAX)
+            return false;
+        *slots[slot] = (LightingEffect)index;
+
+        value += length;
+        if (*value != (slot < 2 ? ',' : '\0'))
+            return false;
+        value++;
+    }
+    return true;
+}
+
+int main(int argc, char **argv)
+{
+    std::string port;
+    std::string backend = "mock";
+    AgentSettings settings;
+    uint32_t statsInterval = 0;
+    bool meter = false;
+    for (int i = 1; i < argc; i++)
+    {
+        bool hasValue = i + 1 < argc;
+        if (strcmp(argv[i], "--port") == 0 && hasValue)
+            port = argv[++i];
+        else if (strcmp(argv[i], "--backend") == 0 && hasValue)
+            backend = argv[++i];
+        else if (strcmp(argv[i], "--mode") == 0 && hasValue)
+        {
+            static const char *modes[] = {"output", "input", "application", "game"};
+            const char *mode = argv[++i];
+            size_t index = 0;
+            while (index < 4 && strcmp(modes[index], mode) != 0)
+                index++;
+            if (index == 4)
+                return Usage(argv[0]);
+            settings.startupMode = (DisplayMode)(DisplayMode::MODE_OUTPUT + index);
+        }
+        else if (strcmp(argv[i], "--effects") == 0 && hasValue)
+        {
+            if (!ParseEffects(argv[++i], settings.device))
+                return Usage(argv[0]);
+        }
+        else if (strcmp(argv[i], "--meter") == 0)
+            meter = true;
+        else if (strcmp(argv[i], "--stats") == 0 && hasValue)
+        {
+            statsInterval = strtoul(argv[++i], NULL, 10) * 1000;
+            if (statsInterval == 0)
+                return Usage(argv[0]);
+        }
+        else if (strcmp(argv[i], "--verbose") == 0)
+            Log::SetLevel(Log::LEVEL_DEBUG);
+        else
+            return Usage(argv[0]);
+    }
+
+    size_t separator = backend.find(':');
+    std::string argument = separator != std::string::npos ? backend.substr(separator + 1) : "";
+    std::unique_ptr<AudioBackend> audio(CreateAudioBackend(backend.substr(0, separator), argument));
+    if (!audio)
+        return Usage(argv[0]);
+
+    EventLoop loop;
+    CommunicationService communication(loop, port);
+    Agent agent(communication, *audio, settings);
+
+    // The agent logs the replies.
+    Timer statsTimer(loop, [&communication]() {
+        if (!communication.IsConnected())
+            return;
+        communication.SendMessage(Command::STATS);
+        communication.SendMessage(Command::DIAGNOSTICS);
+    });
+    if (statsInterval > 0)
+        statsTimer.Start(statsInterval, true);
+
+    // Same 30 Hz the device updates the ring at, 3 bytes a frame.
+    Timer meterTimer(loop, [&agent]() { agent.SendPeakLevels(); });
+    if (meter)
+        meterTimer.Start(33, true);
+
+    audio->OnServiceStarted = [&communication]() { communication.Start(); };
+    if (!audio->Start(loop))
+        return 1;
+
+    loop.Run();
+
+    communication.Stop();
+    audio->Stop();
+    const CommunicationService::Stats &stats = communication.GetStats();
+    Log::Info("Read %u messages (%u bytes), wrote %u messages (%u bytes), %u errors",
+              stats.readCount, stats.readBytes, stats.writeCount, stats.writeBytes, stats.errorCount);
+    return 0;
+}
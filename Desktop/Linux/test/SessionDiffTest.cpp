@@ -0,0 +1,235 @@
+//********************************************************
+// PROJECT: MAXMIX
+//
+// DECRIPTION:
+// Unit tests of SessionDiff::Update and SessionDiff::Flush:
+// the messages sent for an insert, a removal, a default
+// change, scrolling past the end of the list and lists past
+// SESSIONS_MAX. Exits with the number of failed checks.
+//
+// USAGE:
+// session-diff-test
+//********************************************************
+#include <stdio.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+#include "SessionDiff.h"
+
+static int s_Failures;
+
+#define CHECK(condition)                                                       \
+    do                                                                         \
+    {                                                                          \
+        if (!(condition))                                                      \
+        {                                                                      \
+            printf("%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #condition); \
+            s_Failures++;                                                      \
+        }                                                                      \
+    } while (0)
+
+// Sessions with ids 1..count, the first one is the default.
+static std::vector<Session> MakeSessions(int count)
+{
+    std::vector<Session> sessions(count);
+    for (int i = 0; i < count; i++)
+    {
+        sessions[i].id = i + 1;
+        sessions[i].name = "Session " + std::to_string(i + 1);
+        sessions[i].volume = i % 101;
+    }
+    sessions[0].isDefault = true;
+    return sessions;
+}
+
+// Device showing sessions at current, nothing left to send.
+static DeviceView MakeDevice(const std::vector<Session> &sessions, uint8_t current)
+{
+    DeviceView device;
+    device.info.mode = DisplayMode::MODE_APPLICATION;
+    device.Invalidate();
+
+    SessionInfo target = device.info;
+    target.current = current;
+    memset(target.sessions, 0, sizeof(target.sessions));
+    target.sessions[GetIndexForMode(target.mode)] = sessions.size() > 255 ? 255 : sessions.size();
+    MessageBatch batch;
+    SessionDiff::Flush(device, target, sessions, batch);
+    return device;
+}
+
+static void Counts(const std::vector<Session> &sessions, uint8_t counts[3])
+{
+    counts[0] = counts[1] = 0;
+    counts[2] = sessions.size() > 255 ? 255 : sessions.size();
+}
+
+static const MessageBatch::Message *Find(const MessageBatch &batch, Command command)
+{
+    for (uint8_t i = 0; i < batch.count; i++)
+    {
+        if (batch.messages[i].command == command)
+            return &batch.messages[i];
+    }
+    return NULL;
+}
+
+static bool IsLast(const MessageBatch &batch, Command command)
+{
+    return batch.count > 0 && batch.messages[batch.count - 1].command == command;
+}
+
+static void TestUnchanged(void)
+{
+    std::vector<Session> sessions = MakeSessions(5);
+    DeviceView device = MakeDevice(sessions, 2);
+    uint8_t counts[3];
+    Counts(sessions, counts);
+
+    MessageBatch batch;
+    SessionDiff::Update(device, sessions, sessions, counts, -1, batch);
+    CHECK(batch.count == 0);
+}
+
+static void TestInsert(void)
+{
+    std::vector<Session> previous = MakeSessions(5);
+    DeviceView device = MakeDevice(previous, 2);
+    std::vector<Session> next = previous;
+    Session session;
+    session.id = 6;
+    session.name = "New";
+    next.push_back(session);
+    uint8_t counts[3];
+    Counts(next, counts);
+
+    // Away from the current slots only the count changes.
+    MessageBatch batch;
+    SessionDiff::Update(device, previous, next, counts, -1, batch);
+    CHECK(batch.count == 1);
+    CHECK(IsLast(batch, Command::SESSION_INFO));
+    CHECK(device.info.current == 2);
+    CHECK(device.info.sessions[2] == 6);
+
+    // Focused, it is shown with both neighbours, SESSION_INFO goes last.
+    std::vector<Session> focused = next;
+    session.id = 7;
+    session.name = "Focused";
+    focused.push_back(session);
+    Counts(focused, counts);
+    batch.Clear();
+    SessionDiff::Update(device, next, focused, counts, 7, batch);
+    CHECK(device.info.current == 6);
+    const MessageBatch::Message *current = Find(batch, Command::CURRENT_SESSION);
+    CHECK(current != NULL && strcmp(((const SessionData *)current->payload)->name, "Focused") == 0);
+    CHECK(Find(batch, Command::PREVIOUS_SESSION) != NULL);
+    CHECK(Find(batch, Command::NEXT_SESSION) != NULL);
+    CHECK(IsLast(batch, Command::SESSION_INFO));
+}
+
+static void TestRemove(void)
+{
+    // The current session goes away, the default one is shown.
+    std::vector<Session> previous = MakeSessions(5);
+    DeviceView device = MakeDevice(previous, 3);
+    std::vector<Session> next = previous;
+    next.erase(next.begin() + 3);
+    uint8_t counts[3];
+    Counts(next, counts);
+
+    MessageBatch batch;
+    SessionDiff::Update(device, previous, next, counts, -1, batch);
+    CHECK(device.info.current == 0);
+    CHECK(strcmp(device.sessions[SessionIndex::INDEX_CURRENT].name, "Session 1") == 0);
+    CHECK(strcmp(device.sessions[SessionIndex::INDEX_PREVIOUS].name, "Session 5") == 0);
+    CHECK(IsLast(batch, Command::SESSION_INFO));
+
+    // Another session moves the current one down by an index, it stays shown.
+    previous = next;
+    next.erase(next.begin() + 1);
+    Counts(next, counts);
+    batch.Clear();
+    SessionDiff::Update(device, previous, next, counts, -1, batch);
+    CHECK(device.info.current == 0);
+    CHECK(Find(batch, Command::CURRENT_SESSION) == NULL);
+    CHECK(strcmp(device.sessions[SessionIndex::INDEX_NEXT].name, "Session 3") == 0);
+}
+
+static void TestDefaultChange(void)
+{
+    // Only the VolumeData of the slots that changed is sent.
+    std::vector<Session> previous = MakeSessions(5);
+    DeviceView device = MakeDevice(previous, 1);
+    std::vector<Session> next = previous;
+    next[0].isDefault = false;
+    next[1].isDefault = true;
+    uint8_t counts[3];
+    Counts(next, counts);
+
+    MessageBatch batch;
+    SessionDiff::Update(device, previous, next, counts, -1, batch);
+    CHECK(batch.count == 2);
+    const MessageBatch::Message *current = Find(batch, Command::VOLUME_CURR_CHANGE);
+    const MessageBatch::Message *before = Find(batch, Command::VOLUME_PREV_CHANGE);
+    CHECK(current != NULL && ((const VolumeData *)current->payload)->isDefault);
+    CHECK(before != NULL && !((const VolumeData *)before->payload)->isDefault);
+    CHECK(batch.GetSize() == 2 * (sizeof(VolumeData) + 1));
+}
+
+static void TestListWrapAround(void)
+{
+    // The last session's next slot is the first one.
+    std::vector<Session> sessions = MakeSessions(4);
+    DeviceView device = MakeDevice(sessions, 3);
+    CHECK(strcmp(device.sessions[SessionIndex::INDEX_NEXT].name, "Session 1") == 0);
+    CHECK(device.sessions[SessionIndex::INDEX_NEXT].data.id == 0);
+    CHECK(device.sessions[SessionIndex::INDEX_PREVIOUS].data.id == 2);
+}
+
+static void TestSessionsMax(void)
+{
+    // 7 bit ids, only the first SESSIONS_MAX sessions are on the device and the count is capped.
+    std::vector<Session> sessions = MakeSessions(200);
+    DeviceView device = MakeDevice(sessions, SESSIONS_MAX - 1);
+    CHECK(device.info.current == SESSIONS_MAX - 1);
+    CHECK(device.info.sessions[2] == SESSIONS_MAX);
+    CHECK(device.sessions[SessionIndex::INDEX_CURRENT].data.id == SESSIONS_MAX - 1);
+    CHECK(strcmp(device.sessions[SessionIndex::INDEX_NEXT].name, "Session 1") == 0);
+    CHECK(device.sessions[SessionIndex::INDEX_NEXT].data.id == 0);
+
+    // A session past it can't be focused, the current one stays.
+    std::vector<Session> next = sessions;
+    Session session;
+    session.id = 201;
+    session.name = "Too far";
+    next.push_back(session);
+    uint8_t counts[3];
+    Counts(next, counts);
+    MessageBatch batch;
+    SessionDiff::Update(device, sessions, next, counts, 201, batch);
+    CHECK(device.info.current == SESSIONS_MAX - 1);
+    CHECK(batch.count == 0);
+
+    // An index past it falls back to the first session.
+    SessionInfo target = device.info;
+    target.current = 150;
+    batch.Clear();
+    SessionDiff::Flush(device, target, next, batch);
+    CHECK(device.info.current == 0);
+    for (const SessionData &shown : device.sessions)
+        CHECK(shown.data.id < SESSIONS_MAX);
+}
+
+int main()
+{
+    TestUnchanged();
+    TestInsert();
+    TestRemove();
+    TestDefaultChange();
+    TestListWrapAround();
+    TestSessionsMax();
+
+    printf("%s: %d failed checks\n", s_Failures ? "FAIL" : "PASS", s_Failures);
+    return s_Failures;
+}
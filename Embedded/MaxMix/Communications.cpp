@@ -1,4 +1,5 @@
 #include "Communications.h"
+#include "src/Protocol/Codec.h"
 
 // Defined in the main file
 extern DeviceSettings g_Settings;
@@ -7,11 +8,118 @@ extern SessionData g_Sessions[4];
 extern ModeStates g_ModeStates;
 extern uint32_t g_HeartbeatTimeout;
 extern uint32_t g_Now;
+extern Diagnostics g_Diagnostics;
+extern PeakLevels g_PeakLevels;
+extern uint32_t g_PeakLevelsTime;
 
 //#define TEST_HARNESS
 
 namespace Communications
 {
+    static LinkStats stats;
+    static ProbeData probe;
+    // Last time Read() found the receive buffer empty, anything read afterwards arrived after this point.
+    static uint32_t lastIdleMicros;
+    // Bit per SessionIndex with a volume change waiting for its interval, see WriteVolume.
+    static uint8_t volumePending;
+    static uint32_t volumeLastWrite[SessionIndex::INDEX_MAX];
+
+    // Last local volume change per slot. Each one is a new epoch, the host acknowledges it by
+    // reporting the same volume, until then its updates for the session predate the change.
+    struct LocalVolume
+    {
+        uint8_t epoch;
+        uint8_t ackedEpoch;
+        VolumeData data;
+        uint32_t time;
+    };
+    static LocalVolume localVolumes[SessionIndex::INDEX_MAX];
+
+    static void OnLocalVolume(uint8_t index)
+    {
+        const VolumeData &data = g_Sessions[index].data;
+        // Slots rotate, drop an older change for the same session kept by another one.
+        for (uint8_t i = 0; i < SessionIndex::INDEX_MAX; i++)
+        {
+            if (localVolumes[i].data.id == data.id)
+                localVolumes[i].ackedEpoch = localVolumes[i].epoch;
+        }
+
+        LocalVolume &local = localVolumes[index];
+        local.epoch++;
+        local.data = data;
+        local.time = g_Now;
+    }
+
+    // Keeps the local volume while the host hasn't caught up with it.
+    static void FilterHostVolume(VolumeData &data)
+    {
+        for (uint8_t i = 0; i < SessionIndex::INDEX_MAX; i++)
+        {
+            LocalVolume &local = localVolumes[i];
+            if (local.epoch == local.ackedEpoch || local.data.id != data.id)
+                continue;
+
+            bool sent = !(volumePending & _BV(i));
+            if (g_Now - local.time >= VOLUME_ACK_TIMEOUT || (sent && data.volume == local.data.volume && data.isMuted == local.data.isMuted))
+            {
+                local.ackedEpoch = local.epoch;
+                continue;
+            }
+
+            data.volume = local.data.volume;
+            data.isMuted = local.data.isMuted;
+        }
+    }
+
+    // Where the payload of a command lives on the device, Protocol::PayloadSize says how much
+    // of it goes over the wire in each direction.
+    static void *PayloadData(Command command)
+    {
+        if (command == Command::SETTINGS)
+            return &g_Settings;
+        else if (command == Command::SESSION_INFO)
+            return &g_SessionInfo;
+        else if (command >= Command::CURRENT_SESSION && command <= Command::NEXT_SESSION)
+            // SessionIndex follows same ordering as Command.
+            return &g_Sessions[command - Command::CURRENT_SESSION];
+        else if (command >= Command::VOLUME_CURR_CHANGE && command <= Command::VOLUME_NEXT_CHANGE)
+            return &g_Sessions[command - Command::VOLUME_CURR_CHANGE].data;
+        else if (command == Command::MODE_STATES)
+            return &g_ModeStates;
+        else if (command == Command::PROBE)
+            // The host only sends hostTime, the first field.
+            return &probe;
+        else if (command == Command::STATS)
+            return &stats;
+        else if (command == Command::DIAGNOSTICS)
+            return &g_Diagnostics;
+        else if (command == Command::PEAK_LEVELS)
+            return &g_PeakLevels;
+        return NULL;
+    }
+
+    static void ReadPayload(Command command)
+    {
+        uint8_t length = Protocol::PayloadSize(command, Protocol::TO_DEVICE);
+        if (length == 0)
+            return;
+
+        size_t count = Serial.readBytes((char *)PayloadData(command), length);
+        stats.bytesRead += count;
+        if (count != length)
+            stats.sizeErrors++;
+    }
+
+    static void WriteFrame(Command command);
+
+    static void WriteVolumeNow(uint8_t index)
+    {
+        volumePending &= ~_BV(index);
+        volumeLastWrite[index] = g_Now;
+        WriteFrame((Command)(Command::VOLUME_CURR_CHANGE + index));
+    }
+
     void Initialize(void)
     {
         Serial.begin(BAUD_RATE);
@@ -20,28 +128,40 @@ namespace Communications
 
     Command Read(void)
     {
-        // Future Notes: Serial.readBytes returns the number of bytes actually read
-        // if necessary, we can use that compared against sizeof(T) to validate message
-        // was recieved in it's entirity. However, if this happens, we should look at Serial timeout first.
+        // Serial.readBytes returns the number of bytes actually read, short payloads are counted
+        // as size errors in the link stats. If these show up, we should look at Serial timeout first.
         Command command = Command::NONE;
-        if (Serial.available())
+        int available = Serial.available();
+        if (available)
         {
+#ifdef SERIAL_RX_BUFFER_SIZE
+            // The hardware serial ring keeps one slot free, once it is full new bytes are discarded.
+            if (available >= SERIAL_RX_BUFFER_SIZE - 1)
+                stats.overflows++;
+#endif
             g_HeartbeatTimeout = g_Now + DEVICE_RESET_AFTER_INACTIVTY;
             command = (Command)Serial.read();
+            stats.bytesRead++;
+            stats.framesRead++;
+            ReadPayload(command);
             if (command == Command::TEST)
                 Write(command);
-            else if (command == Command::SETTINGS)
-                Serial.readBytes((char *)&g_Settings, sizeof(DeviceSettings));
-            else if (command == Command::SESSION_INFO)
-                Serial.readBytes((char *)&g_SessionInfo, sizeof(SessionInfo));
             else if (command >= Command::CURRENT_SESSION && command <= Command::NEXT_SESSION)
-                // SessionIndex follows same ordering as Command.
-                Serial.readBytes((char *)&g_Sessions[command - Command::CURRENT_SESSION], sizeof(SessionData));
+                FilterHostVolume(g_Sessions[command - Command::CURRENT_SESSION].data);
             else if (command >= Command::VOLUME_CURR_CHANGE && command <= Command::VOLUME_NEXT_CHANGE)
-                // SessionIndex follows same ordering as Command.
-                Serial.readBytes((char *)&g_Sessions[command - Command::VOLUME_CURR_CHANGE].data, sizeof(VolumeData));
-            else if (command == Command::MODE_STATES)
-                Serial.readBytes((char *)&g_ModeStates, sizeof(ModeStates));
+                FilterHostVolume(g_Sessions[command - Command::VOLUME_CURR_CHANGE].data);
+            else if (command == Command::PEAK_LEVELS)
+                g_PeakLevelsTime = g_Now;
+            else if (command == Command::PROBE)
+            {
+                probe.deviceTime = micros();
+                probe.queuedTime = probe.deviceTime - lastIdleMicros;
+                Write(command);
+            }
+            else if (command == Command::STATS || command == Command::DIAGNOSTICS)
+                Write(command);
+            else if (!Protocol::IsCommand(command))
+                stats.unknownCommands++;
             // Do nothing: DEBUG, NONE, ERROR?
 #ifdef TEST_HARNESS
             else if (command == Command::DEBUG)
@@ -60,28 +180,84 @@ namespace Communications
 #endif
             Write(Command::OK);
         }
+        else
+        {
+            lastIdleMicros = micros();
+        }
         return command;
     }
 
     void Write(Command command)
+    {
+        // The host tracks what each slot holds, pending volume changes must reach it before slots
+        // are updated or rotated. Volume changes sent directly replace the pending one.
+        if (command >= Command::VOLUME_CURR_CHANGE && command <= Command::VOLUME_NEXT_CHANGE)
+        {
+            volumePending &= ~_BV(command - Command::VOLUME_CURR_CHANGE);
+            OnLocalVolume(command - Command::VOLUME_CURR_CHANGE);
+        }
+        if (volumePending && command >= Command::SESSION_INFO && command <= Command::MODE_STATES)
+        {
+            for (uint8_t i = 0; i < SessionIndex::INDEX_MAX; i++)
+            {
+                if (volumePending & _BV(i))
+                    WriteVolumeNow(i);
+            }
+        }
+        WriteFrame(command);
+    }
+
+    void WriteVolume(SessionIndex index)
+    {
+        OnLocalVolume(index);
+        if (g_Now - volumeLastWrite[index] >= VOLUME_WRITE_INTERVAL)
+            WriteVolumeNow(index);
+        else
+            volumePending |= _BV(index);
+    }
+
+    void Update(void)
+    {
+        for (uint8_t i = 0; volumePending && i < SessionIndex::INDEX_MAX; i++)
+        {
+            if ((volumePending & _BV(i)) && g_Now - volumeLastWrite[i] >= VOLUME_WRITE_INTERVAL)
+                WriteVolumeNow(i);
+        }
+    }
+
+    void Reset(void)
+    {
+        volumePending = 0;
+        for (uint8_t i = 0; i < SessionIndex::INDEX_MAX; i++)
+            localVolumes[i].ackedEpoch = localVolumes[i].epoch;
+    }
+
+    static void WriteFrame(Command command)
     {
         // Do nothing: DEBUG, NONE, ERROR
         if (command == Command::ERROR || command == Command::NONE || command == Command::DEBUG)
             return;
 
-        Serial.write(command);
-        if (command == Command::TEST)
-            Serial.println(F(VERSION));
-        else if (command == Command::SETTINGS)
-            Serial.write((char *)&g_Settings, sizeof(DeviceSettings));
-        else if (command == Command::SESSION_INFO)
-            Serial.write((char *)&g_SessionInfo, sizeof(SessionInfo));
-        else if (command >= Command::CURRENT_SESSION && command <= Command::NEXT_SESSION)
-            Serial.write((char *)&g_Sessions[command - Command::CURRENT_SESSION], sizeof(SessionData));
-        else if (command >= Command::VOLUME_CURR_CHANGE && command <= Command::VOLUME_NEXT_CHANGE)
-            Serial.write((char *)&g_Sessions[command - Command::VOLUME_CURR_CHANGE].data, sizeof(VolumeData));
-        else if (command == Command::MODE_STATES)
-            Serial.write((char *)&g_ModeStates, sizeof(ModeStates));
+        uint8_t length = Protocol::PayloadSize(command, Protocol::TO_HOST);
+        if (length == Protocol::PAYLOAD_LINE)
+        {
+            // TEST replies with the version line.
+            stats.bytesWritten += Serial.write(command);
+            stats.bytesWritten += Serial.println(F(VERSION));
+        }
+        else
+        {
+            uint8_t frame[Protocol::FRAME_MAX];
+            // Interrupts update most of the diagnostics, take a consistent copy.
+            if (command == Command::DIAGNOSTICS)
+                cli();
+            // The stats snapshot is taken before this frame is counted.
+            size_t size = Protocol::Encode(command, PayloadData(command), length, frame);
+            if (command == Command::DIAGNOSTICS)
+                sei();
+            stats.bytesWritten += Serial.write((const char *)frame, size);
+        }
+        stats.framesWritten++;
         // command == Command::OK just replies with command
         // Send buffered data
         Serial.flush();
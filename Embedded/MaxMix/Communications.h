@@ -7,4 +7,11 @@ namespace Communications
     void Initialize(void);
     Command Read(void);
     void Write(Command command);
+    // Encoder volume changes: the first goes out right away, then at most one per
+    // VOLUME_WRITE_INTERVAL per session while they keep coming.
+    void WriteVolume(SessionIndex index);
+    // Sends coalesced volume changes whose interval is over, call every loop.
+    void Update(void);
+    // Drops coalesced volume changes that haven't gone out yet, and forgets local changes the host hasn't acknowledged.
+    void Reset(void);
 }
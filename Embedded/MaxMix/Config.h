@@ -20,7 +20,7 @@
 // *** DEFINES
 //********************************************************
 #ifndef VERSION
-    #define VERSION "1.5.6"
+    #define VERSION "1.6.0"
 #endif
 
 //********************************************************
@@ -33,6 +33,10 @@ static const uint32_t BAUD_RATE = 76800;
 // Try avoiding 115200 or 230400 baud rates as Atmega328p leaves not much recovery headroom at these baud rates, especialy for arduino clones.
 // our longest message at 296 bits (33 bytes) takes 2.29ms to send.
 static const uint64_t SERIAL_TIMEOUT = 10;
+// Encoder volume changes to the same session are coalesced to one per interval, 30 updates a second still feel immediate.
+static const uint8_t VOLUME_WRITE_INTERVAL = 33; // ms
+// Host volume updates that disagree with the last local change are echoes of older ones, until the host reports it or this passes.
+static const uint16_t VOLUME_ACK_TIMEOUT = 500; // ms
 
 // --- Pins
 #if defined(ARDUINO_AVR_NANO)
@@ -42,6 +46,8 @@ static const uint64_t SERIAL_TIMEOUT = 10;
     static const uint8_t  PIN_ENCODER_SWITCH = 17; //A3
     // OLED SDA - 18 //A4
     // OLED SCL - 19 //A5
+    // Encoder A/B are PCINT9/PCINT10, decode them on their edges instead of polling.
+    #define ENCODER_PCINT_vect PCINT1_vect
 #elif defined(ARDUINO_AVR_PROMICRO16) || defined(ARDUINO_AVR_PROMICRO)
     static const uint8_t  PIN_PIXELS = 15; //15
     static const uint8_t  PIN_ENCODER_OUTA = 19; //A1
@@ -74,18 +80,48 @@ static const uint8_t STATE_GAME_MAX = 3;
 // --- Display
 static const uint8_t DISPLAY_RESET = 4; // Reset pin # (or -1 if sharing Arduino reset pin)
 static const uint32_t DISPLAY_SPEED = 400000;
+static const bool DISPLAY_PAGE_BUFFER = true; // Screens are drawn a page at a time into 128 bytes instead of a 512 byte frame.
 
 // --- Lighting
 static const uint8_t PIXELS_COUNT = 8;      // Number of pixels in ring
 static const uint8_t PIXELS_BRIGHTNESS = 96; // Master brightness of all the pixels. [0..255] Be carefull of the current draw on the USB port.
+static const uint8_t PIXELS_UPDATE_INTERVAL = 33; // ms, 30Hz
+static const uint8_t PIXELS_PALETTE_SHIFT = 4; // Gradients keep a color every 16 steps of the 0..255 blend,
+static const uint8_t PIXELS_PALETTE_SIZE = (255 >> PIXELS_PALETTE_SHIFT) + 2; // plus the end color.
+// Palette fractions are dithered over 1 << bits frames, [0..4] 0 rounds them instead. At 30Hz one bit
+// alternates frames at 15Hz, two bits would add quarter steps that repeat at 7.5Hz and flicker at low brightness.
+static const uint8_t PIXELS_DITHER_BITS = 1;
+static const uint8_t PEAK_METER_TIMEOUT = 250; // ms without PeakLevels before going back to the volume ring
+static const uint16_t PEAK_METER_DELAY = 1000;  // ms the volume ring stays up after any input
+static const uint8_t PEAK_METER_FALLOFF = 24;   // Meter drop per frame [0..255], peaks jump up right away
+static const uint16_t PIXELS_SHOW_TIME = PIXELS_COUNT * 30 + 60; // us show() keeps interrupts off, 24 bits at 1.25us per pixel plus margin.
 
 // --- Rotary Encoder
 static const uint16_t ROTARY_ACCELERATION_DIVISOR_MAX = 400;
+static const AccelerationCurve ROTARY_ACCELERATION_CURVE = AccelerationCurve::CURVE_QUADRATIC;
+static const uint8_t ROTARY_ACCELERATION_REFERENCE = 40;  // Detents per second where all curves give the same step.
+static const uint8_t ROTARY_ACCELERATION_STEP_MAX = 100;
+static const uint8_t ROTARY_ACCELERATION_BUCKETS = 48;   // Detent intervals up to 255ms, see GetAccelerationBucket().
+static const uint16_t ROTARY_VELOCITY_RESET = 250;  // ms, after a longer pause acceleration starts over.
+
+// --- Input
+static const uint8_t INPUT_EVENTS_SIZE = 16; // Encoder and button events buffered between two loops, power of two.
+// Modes where a tap toggles the mode state on release instead of after the double tap window.
+// It is undone if the release turns into a double tap, game mode selects sessions on tap and keeps waiting.
+static const uint8_t BUTTON_EARLY_TAP_MODES = _BV(DisplayMode::MODE_OUTPUT) | _BV(DisplayMode::MODE_INPUT) | _BV(DisplayMode::MODE_APPLICATION);
+
+// --- Timer
+#if defined(ENCODER_PCINT_vect)
+static const uint32_t TIMER_PERIOD = 5000; // us, only the encoder button is polled, well under its 15ms debounce.
+#else
+static const uint32_t TIMER_PERIOD = 1000; // us, the encoder is polled too, one sample per quadrature state at fast spins.
+#endif
 
 // --- Screen Drawing
 static const uint8_t DISPLAY_WIDTH = 128;
 static const uint8_t DISPLAY_HEIGHT = 32;
 static const uint8_t DISPLAY_ADDRESS = 0x3C;
+static const uint8_t DISPLAY_ROTATION = 2; // Quarter turns, Sprites.h is generated for it.
 
 static const uint8_t DISPLAY_CHAR_WIDTH_X1 = 5;
 static const uint8_t DISPLAY_CHAR_HEIGHT_X1 = 7;
@@ -116,6 +152,11 @@ static const uint8_t DISPLAY_WIDGET_VOLUMEBAR_WIDTH_X2 = DISPLAY_AREA_CENTER_WID
 
 static const uint8_t DISPLAY_WIDGET_DOTGROUP_WIDTH = (DisplayMode::MODE_MAX - 1) * DISPLAY_WIDGET_DOT_SIZE_X1 + DISPLAY_WIDGET_DOT_SIZE_X2 + (DisplayMode::MODE_MAX - 1) * DISPLAY_MARGIN_X2;
 static const uint8_t DISPLAY_WIDGET_DOTGROUP_HEIGHT = DISPLAY_WIDGET_DOT_SIZE_X2;
+// Peak meter strip in the right margin of the edit screens, pushed on its own at up to DISPLAY_METER_INTERVAL.
+static const uint8_t DISPLAY_WIDGET_METER_X = DISPLAY_WIDTH - DISPLAY_AREA_CENTER_MARGIN_SIDE + DISPLAY_MARGIN_X2;
+static const uint8_t DISPLAY_WIDGET_METER_WIDTH = 2;
+static const uint8_t DISPLAY_WIDGET_METER_STEP = 2; // Rows per level, 15 levels fill 30 of the 32 rows
+static const uint8_t DISPLAY_METER_INTERVAL = 40;   // ms, 25Hz
 
 static const SQ15x16 DISPLAY_SCROLL_SPEED_X2 = 3.0;  // Chars per second
 static const SQ15x16 DISPLAY_SCROLL_SPEED_X1 = 4.0;  // Chars per second
@@ -1,5 +1,13 @@
 #include "Display.h"
 #include "Logo.h"
+#include "Sprites.h"
+#include "src/MonoCanvas/SSD1306Canvas.h"
+
+// Size, rotation and buffer are template arguments, drawing inlines down to the buffer.
+// display-benchmark defines it to draw the same screens on the classes it compares with, see Native/bench/DisplayVariant.h.
+#ifndef DISPLAY_CLASS
+#define DISPLAY_CLASS SSD1306Canvas<DISPLAY_WIDTH, DISPLAY_HEIGHT, DISPLAY_ROTATION, DISPLAY_PAGE_BUFFER ? 1 : DISPLAY_HEIGHT / 8>
+#endif
 
 namespace Display
 {
@@ -24,21 +32,55 @@ namespace Display
     //---------------------------------------------------------
     // Display & Display Functions
     //---------------------------------------------------------
-    static Adafruit_SSD1306 display(DISPLAY_WIDTH, DISPLAY_HEIGHT, &Wire, DISPLAY_RESET);
+    static DISPLAY_CLASS display(DISPLAY_RESET);
 
     void Initialize(void)
     {
-        Wire.setClock(DISPLAY_SPEED);
         display.begin(SSD1306_SWITCHCAPVCC, DISPLAY_ADDRESS);
-        display.setRotation(2);
+        // Wire.begin() resets the clock, the canvas keeps whatever is set.
+        Wire.setClock(DISPLAY_SPEED);
         display.setTextWrap(false);
     }
 
     void Sleep(void)
     {
         // TODO: replace with display off
-        display.clearDisplay();
-        display.display();
+        display.firstPage();
+        do
+        {
+            display.clearDisplay();
+        } while (display.nextPage());
+    }
+
+    //---------------------------------------------------------
+    // Peak Meter Functions
+    //---------------------------------------------------------
+    static uint8_t peakLevel;
+
+    static void DrawPeakMeter(void)
+    {
+        uint8_t height = peakLevel * DISPLAY_WIDGET_METER_STEP;
+        display.fillRect(DISPLAY_WIDGET_METER_X, 0, DISPLAY_WIDGET_METER_WIDTH, DISPLAY_HEIGHT - height, BLACK);
+        if (height > 0)
+            display.fillRect(DISPLAY_WIDGET_METER_X, DISPLAY_HEIGHT - height, DISPLAY_WIDGET_METER_WIDTH, height, WHITE);
+    }
+
+    void SetPeakMeter(uint8_t level)
+    {
+        peakLevel = level;
+    }
+
+    void UpdatePeakMeter(uint8_t level)
+    {
+        peakLevel = level;
+        // Only the strip's columns go out, one window over every page then 2 bytes a page:
+        // 19 bytes in 5 transfers with the page buffer, a whole frame is 539. The display is
+        // rotated, the strip is mirrored in the controller RAM.
+        display.firstPage(DISPLAY_WIDTH - DISPLAY_WIDGET_METER_X - DISPLAY_WIDGET_METER_WIDTH, DISPLAY_WIDGET_METER_WIDTH);
+        do
+        {
+            DrawPeakMeter();
+        } while (display.nextPage());
     }
 
     //---------------------------------------------------------
@@ -79,8 +121,12 @@ namespace Display
         if (nameLength > charMax)
             scroll = max(0, displayTimer[timerIndex] - DISPLAY_SCROLL_IDLE_TIME) * scrollMax / (nameLength / scrollSpeed);
 
+        // Screens are drawn once per page, restart here so every page sees the same position.
         if (abs(scroll) >= abs(scrollMax))
+        {
             displayTimer[timerIndex] = 0;
+            scroll = 0;
+        }
 
         display.setTextSize(fontSize);
         display.setTextColor(WHITE);
@@ -131,17 +177,14 @@ namespace Display
 
     static void DrawVolumeNumber(uint8_t volume, uint8_t x0, uint8_t y0)
     {
-        x0 = x0 - DISPLAY_CHAR_WIDTH_X2;
-        if (volume > 9)
-            x0 = x0 - DISPLAY_CHAR_WIDTH_X2 - DISPLAY_CHAR_SPACING_X2;
-        if (volume > 99)
-            x0 = x0 - DISPLAY_CHAR_WIDTH_X2 - DISPLAY_CHAR_SPACING_X2;
-
-        display.setTextSize(2);
-        display.setTextColor(WHITE);
-        display.setCursor(x0, y0);
-
-        display.print(volume);
+        // Right aligned, digits are copied from the last one back.
+        do
+        {
+            x0 -= DISPLAY_CHAR_WIDTH_X2;
+            display.drawSprite(x0, y0, SPRITE_DIGITS_X2[volume % 10]);
+            x0 -= DISPLAY_CHAR_SPACING_X2;
+            volume /= 10;
+        } while (volume > 0);
     }
 
     static void DrawDotGroup(uint8_t index)
@@ -167,31 +210,11 @@ namespace Display
 
     static void DrawSelectionArrows(bool leftArrow, bool rightArrow)
     {
-        uint8_t x0, y0, x1, y1, x2, y2;
-
         if (leftArrow)
-        {
-            x0 = 0;
-            y0 = DISPLAY_MARGIN_X2 + DISPLAY_WIDGET_ARROW_SIZE_X1;
-            x1 = x0 + DISPLAY_WIDGET_ARROW_SIZE_X1;
-            y1 = y0 - DISPLAY_WIDGET_ARROW_SIZE_X1;
-            x2 = x0 + DISPLAY_WIDGET_ARROW_SIZE_X1;
-            y2 = y0 + DISPLAY_WIDGET_ARROW_SIZE_X1;
-
-            display.fillTriangle(x0, y0, x1, y1, x2, y2, WHITE);
-        }
+            display.drawSprite(0, DISPLAY_MARGIN_X2, SPRITE_ARROW_LEFT);
 
         if (rightArrow)
-        {
-            x0 = DISPLAY_WIDTH - 1;
-            y0 = DISPLAY_MARGIN_X2 + DISPLAY_WIDGET_ARROW_SIZE_X1;
-            x1 = x0 - DISPLAY_WIDGET_ARROW_SIZE_X1;
-            y1 = y0 - DISPLAY_WIDGET_ARROW_SIZE_X1;
-            x2 = x0 - DISPLAY_WIDGET_ARROW_SIZE_X1;
-            y2 = y0 + DISPLAY_WIDGET_ARROW_SIZE_X1;
-
-            display.fillTriangle(x0, y0, x1, y1, x2, y2, WHITE);
-        }
+            display.drawSprite(DISPLAY_WIDTH - 1 - DISPLAY_WIDGET_ARROW_SIZE_X1, DISPLAY_MARGIN_X2, SPRITE_ARROW_RIGHT);
     }
 
     //---------------------------------------------------------
@@ -199,9 +222,12 @@ namespace Display
     //---------------------------------------------------------
     void SplashScreen(void)
     {
-        display.clearDisplay();
-        display.drawBitmap(0, 0, LOGOBMP, LOGO_WIDTH, LOGO_HEIGHT, 1);
-        display.display();
+        display.firstPage();
+        do
+        {
+            display.clearDisplay();
+            display.drawBitmap(0, 0, LOGOBMP, LOGO_WIDTH, LOGO_HEIGHT, 1);
+        } while (display.nextPage());
     }
 
     //---------------------------------------------------------
@@ -209,18 +235,20 @@ namespace Display
     //---------------------------------------------------------
     void InfoScreen(void)
     {
-        display.clearDisplay();
+        display.firstPage();
+        do
+        {
+            display.clearDisplay();
 
-        display.setTextColor(WHITE);
-        display.setTextSize(1);
+            display.setTextColor(WHITE);
+            display.setTextSize(1);
 
-        display.setCursor(0, (DISPLAY_HEIGHT / 2) - DISPLAY_CHAR_HEIGHT_X1);
-        display.print(F("FW: " VERSION));
-        
-        display.setCursor(0, (DISPLAY_HEIGHT / 2) + DISPLAY_CHAR_SPACING_X2);
-        display.print(F("Built " __DATE__));
+            display.setCursor(0, (DISPLAY_HEIGHT / 2) - DISPLAY_CHAR_HEIGHT_X1);
+            display.print(F("FW: " VERSION));
 
-        display.display();
+            display.setCursor(0, (DISPLAY_HEIGHT / 2) + DISPLAY_CHAR_SPACING_X2);
+            display.print(F("Built " __DATE__));
+        } while (display.nextPage());
     }
 
     //---------------------------------------------------------
@@ -228,29 +256,34 @@ namespace Display
     //---------------------------------------------------------
     void DeviceSelectScreen(SessionData *item, bool leftArrow, bool rightArrow, uint8_t modeIndex)
     {
-        display.clearDisplay();
-
-        DrawDotGroup(modeIndex);
-        DrawItemName(item->name, 2, DISPLAY_CHAR_WIDTH_X2, DISPLAY_CHAR_HEIGHT_X2, DISPLAY_CHAR_SPACING_X2, DISPLAY_CHAR_MAX_X2, DISPLAY_AREA_CENTER_MARGIN_SIDE, 0, DISPLAY_TIMER_A, DISPLAY_SCROLL_SPEED_X2);
-        DrawSelectionArrows(leftArrow, rightArrow);
-        DrawVolumeBar(item, DISPLAY_AREA_CENTER_MARGIN_SIDE, DISPLAY_CHAR_HEIGHT_X2 + DISPLAY_MARGIN_X2, DISPLAY_WIDGET_VOLUMEBAR_WIDTH_X1, DISPLAY_WIDGET_VOLUMEBAR_HEIGHT_X1);
+        display.firstPage();
+        do
+        {
+            display.clearDisplay();
 
-        if (item->data.isDefault)
-            DrawSelectionChannelName('*');
+            DrawDotGroup(modeIndex);
+            DrawItemName(item->name, 2, DISPLAY_CHAR_WIDTH_X2, DISPLAY_CHAR_HEIGHT_X2, DISPLAY_CHAR_SPACING_X2, DISPLAY_CHAR_MAX_X2, DISPLAY_AREA_CENTER_MARGIN_SIDE, 0, DISPLAY_TIMER_A, DISPLAY_SCROLL_SPEED_X2);
+            DrawSelectionArrows(leftArrow, rightArrow);
+            DrawVolumeBar(item, DISPLAY_AREA_CENTER_MARGIN_SIDE, DISPLAY_CHAR_HEIGHT_X2 + DISPLAY_MARGIN_X2, DISPLAY_WIDGET_VOLUMEBAR_WIDTH_X1, DISPLAY_WIDGET_VOLUMEBAR_HEIGHT_X1);
 
-        display.display();
+            if (item->data.isDefault)
+                DrawSelectionChannelName('*');
+        } while (display.nextPage());
     }
 
     void DeviceEditScreen(SessionData *item, const char *label, uint8_t modeIndex)
     {
-        display.clearDisplay();
-
-        DrawDotGroup(modeIndex);
-        DrawItemName(label, 2, DISPLAY_CHAR_WIDTH_X2, DISPLAY_CHAR_HEIGHT_X2, DISPLAY_CHAR_SPACING_X2, DISPLAY_CHAR_MAX_X2, DISPLAY_AREA_CENTER_MARGIN_SIDE, 0, DISPLAY_TIMER_A, DISPLAY_SCROLL_SPEED_X2);
-        DrawVolumeBar(item, DISPLAY_AREA_CENTER_MARGIN_SIDE, DISPLAY_CHAR_HEIGHT_X2 + DISPLAY_MARGIN_X2, DISPLAY_WIDGET_VOLUMEBAR_WIDTH_X1, DISPLAY_WIDGET_VOLUMEBAR_HEIGHT_X1);
-        DrawVolumeNumber(item->data.volume, DISPLAY_AREA_CENTER_MARGIN_SIDE + DISPLAY_AREA_CENTER_WIDTH, 0);
-
-        display.display();
+        display.firstPage();
+        do
+        {
+            display.clearDisplay();
+
+            DrawDotGroup(modeIndex);
+            DrawItemName(label, 2, DISPLAY_CHAR_WIDTH_X2, DISPLAY_CHAR_HEIGHT_X2, DISPLAY_CHAR_SPACING_X2, DISPLAY_CHAR_MAX_X2, DISPLAY_AREA_CENTER_MARGIN_SIDE, 0, DISPLAY_TIMER_A, DISPLAY_SCROLL_SPEED_X2);
+            DrawVolumeBar(item, DISPLAY_AREA_CENTER_MARGIN_SIDE, DISPLAY_CHAR_HEIGHT_X2 + DISPLAY_MARGIN_X2, DISPLAY_WIDGET_VOLUMEBAR_WIDTH_X1, DISPLAY_WIDGET_VOLUMEBAR_HEIGHT_X1);
+            DrawVolumeNumber(item->data.volume, DISPLAY_AREA_CENTER_MARGIN_SIDE + DISPLAY_AREA_CENTER_WIDTH, 0);
+            DrawPeakMeter();
+        } while (display.nextPage());
     }
 
     //---------------------------------------------------------
@@ -258,26 +291,31 @@ namespace Display
     //---------------------------------------------------------
     void ApplicationSelectScreen(SessionData *item, bool leftArrow, bool rightArrow, uint8_t modeIndex)
     {
-        display.clearDisplay();
-
-        DrawDotGroup(modeIndex);
-        DrawItemName(item->name, 2, DISPLAY_CHAR_WIDTH_X2, DISPLAY_CHAR_HEIGHT_X2, DISPLAY_CHAR_SPACING_X2, DISPLAY_CHAR_MAX_X2, DISPLAY_AREA_CENTER_MARGIN_SIDE, 0, DISPLAY_TIMER_A, DISPLAY_SCROLL_SPEED_X2);
-        DrawSelectionArrows(leftArrow, rightArrow);
-        DrawVolumeBar(item, DISPLAY_AREA_CENTER_MARGIN_SIDE, DISPLAY_CHAR_HEIGHT_X2 + DISPLAY_MARGIN_X2, DISPLAY_WIDGET_VOLUMEBAR_WIDTH_X1, DISPLAY_WIDGET_VOLUMEBAR_HEIGHT_X1);
+        display.firstPage();
+        do
+        {
+            display.clearDisplay();
 
-        display.display();
+            DrawDotGroup(modeIndex);
+            DrawItemName(item->name, 2, DISPLAY_CHAR_WIDTH_X2, DISPLAY_CHAR_HEIGHT_X2, DISPLAY_CHAR_SPACING_X2, DISPLAY_CHAR_MAX_X2, DISPLAY_AREA_CENTER_MARGIN_SIDE, 0, DISPLAY_TIMER_A, DISPLAY_SCROLL_SPEED_X2);
+            DrawSelectionArrows(leftArrow, rightArrow);
+            DrawVolumeBar(item, DISPLAY_AREA_CENTER_MARGIN_SIDE, DISPLAY_CHAR_HEIGHT_X2 + DISPLAY_MARGIN_X2, DISPLAY_WIDGET_VOLUMEBAR_WIDTH_X1, DISPLAY_WIDGET_VOLUMEBAR_HEIGHT_X1);
+        } while (display.nextPage());
     }
 
     void ApplicationEditScreen(SessionData *item, uint8_t modeIndex)
     {
-        display.clearDisplay();
-
-        DrawDotGroup(modeIndex);
-        DrawItemName(item->name, 1, DISPLAY_CHAR_WIDTH_X1, DISPLAY_CHAR_HEIGHT_X1, DISPLAY_CHAR_SPACING_X1, DISPLAY_CHAR_MAX_X1, DISPLAY_AREA_CENTER_MARGIN_SIDE, 0, DISPLAY_TIMER_A, DISPLAY_SCROLL_SPEED_X1);
-        DrawVolumeBar(item, DISPLAY_AREA_CENTER_MARGIN_SIDE, DISPLAY_CHAR_HEIGHT_X1 + DISPLAY_MARGIN_X2, DISPLAY_WIDGET_VOLUMEBAR_WIDTH_X2, DISPLAY_WIDGET_VOLUMEBAR_HEIGHT_X2);
-        DrawVolumeNumber(item->data.volume, DISPLAY_WIDTH - DISPLAY_AREA_CENTER_MARGIN_SIDE, DISPLAY_CHAR_HEIGHT_X1 + DISPLAY_MARGIN_X2);
-
-        display.display();
+        display.firstPage();
+        do
+        {
+            display.clearDisplay();
+
+            DrawDotGroup(modeIndex);
+            DrawItemName(item->name, 1, DISPLAY_CHAR_WIDTH_X1, DISPLAY_CHAR_HEIGHT_X1, DISPLAY_CHAR_SPACING_X1, DISPLAY_CHAR_MAX_X1, DISPLAY_AREA_CENTER_MARGIN_SIDE, 0, DISPLAY_TIMER_A, DISPLAY_SCROLL_SPEED_X1);
+            DrawVolumeBar(item, DISPLAY_AREA_CENTER_MARGIN_SIDE, DISPLAY_CHAR_HEIGHT_X1 + DISPLAY_MARGIN_X2, DISPLAY_WIDGET_VOLUMEBAR_WIDTH_X2, DISPLAY_WIDGET_VOLUMEBAR_HEIGHT_X2);
+            DrawVolumeNumber(item->data.volume, DISPLAY_WIDTH - DISPLAY_AREA_CENTER_MARGIN_SIDE, DISPLAY_CHAR_HEIGHT_X1 + DISPLAY_MARGIN_X2);
+            DrawPeakMeter();
+        } while (display.nextPage());
     }
 
     //---------------------------------------------------------
@@ -285,25 +323,29 @@ namespace Display
     //---------------------------------------------------------
     void GameSelectScreen(SessionData *item, char channel, bool leftArrow, bool rightArrow, uint8_t modeIndex)
     {
-        display.clearDisplay();
-
-        DrawDotGroup(modeIndex);
-        DrawItemName(item->name, 2, DISPLAY_CHAR_WIDTH_X2, DISPLAY_CHAR_HEIGHT_X2, DISPLAY_CHAR_SPACING_X2, DISPLAY_CHAR_MAX_X2, DISPLAY_AREA_CENTER_MARGIN_SIDE, 0, DISPLAY_TIMER_A, DISPLAY_SCROLL_SPEED_X2);
-        DrawSelectionArrows(leftArrow, rightArrow);
-        DrawVolumeBar(item, DISPLAY_AREA_CENTER_MARGIN_SIDE, DISPLAY_CHAR_HEIGHT_X2 + DISPLAY_MARGIN_X2, DISPLAY_WIDGET_VOLUMEBAR_WIDTH_X1, DISPLAY_WIDGET_VOLUMEBAR_HEIGHT_X1);
-        DrawSelectionChannelName(channel);
-
-        display.display();
+        display.firstPage();
+        do
+        {
+            display.clearDisplay();
+
+            DrawDotGroup(modeIndex);
+            DrawItemName(item->name, 2, DISPLAY_CHAR_WIDTH_X2, DISPLAY_CHAR_HEIGHT_X2, DISPLAY_CHAR_SPACING_X2, DISPLAY_CHAR_MAX_X2, DISPLAY_AREA_CENTER_MARGIN_SIDE, 0, DISPLAY_TIMER_A, DISPLAY_SCROLL_SPEED_X2);
+            DrawSelectionArrows(leftArrow, rightArrow);
+            DrawVolumeBar(item, DISPLAY_AREA_CENTER_MARGIN_SIDE, DISPLAY_CHAR_HEIGHT_X2 + DISPLAY_MARGIN_X2, DISPLAY_WIDGET_VOLUMEBAR_WIDTH_X1, DISPLAY_WIDGET_VOLUMEBAR_HEIGHT_X1);
+            DrawSelectionChannelName(channel);
+        } while (display.nextPage());
     }
 
     void GameEditScreen(SessionData *itemA, SessionData *itemB, uint8_t modeIndex)
     {
-        display.clearDisplay();
-
-        DrawDotGroup(modeIndex);
-        DrawGameEditItem(itemA, DISPLAY_MARGIN_X2, DISPLAY_TIMER_A);
-        DrawGameEditItem(itemB, DISPLAY_CHAR_HEIGHT_X1 + DISPLAY_MARGIN_X2 * 2 + DISPLAY_MARGIN_X1, DISPLAY_TIMER_B);
+        display.firstPage();
+        do
+        {
+            display.clearDisplay();
 
-        display.display();
+            DrawDotGroup(modeIndex);
+            DrawGameEditItem(itemA, DISPLAY_MARGIN_X2, DISPLAY_TIMER_A);
+            DrawGameEditItem(itemB, DISPLAY_CHAR_HEIGHT_X1 + DISPLAY_MARGIN_X2 * 2 + DISPLAY_MARGIN_X1, DISPLAY_TIMER_B);
+        } while (display.nextPage());
     }
 }; // namespace Display
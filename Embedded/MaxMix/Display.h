@@ -15,6 +15,11 @@ namespace Display
 
     void Sleep(void);
 
+    // Level drawn by the next edit screen.
+    void SetPeakMeter(uint8_t level);
+    // Redraws the peak meter and sends only its strip to the display.
+    void UpdatePeakMeter(uint8_t level);
+
     void SplashScreen(void);
     void InfoScreen(void);
 
@@ -1,40 +1,40 @@
 #pragma once
 
-enum Command : int8_t
+// Wire enums live in the shared protocol library so native host tools build against the exact same definitions.
+#include "src/Protocol/Messages.h"
+
+// Firmware only, what an InputEvent reports.
+enum InputEventType : uint8_t
 {
-    ERROR = -1,
-    NONE = 0,
-    TEST = 1,
-    OK,
-    SETTINGS,
-    SESSION_INFO,
-    CURRENT_SESSION,
-    ALTERNATE_SESSION,
-    PREVIOUS_SESSION,
-    NEXT_SESSION,
-    VOLUME_CURR_CHANGE,
-    VOLUME_ALT_CHANGE,
-    VOLUME_PREV_CHANGE,
-    VOLUME_NEXT_CHANGE,
-    MODE_STATES,
-    DEBUG
+    INPUT_STEP_CW,
+    INPUT_STEP_CCW,
+    INPUT_RELEASE, // Short press released, becomes a tap unless a second press makes it a double tap.
+    INPUT_TAP,
+    INPUT_DOUBLE_TAP,
+    INPUT_HOLD
 };
 
-enum SessionIndex : uint8_t
+// Firmware only, shape of the encoder acceleration, see ROTARY_ACCELERATION_CURVE.
+enum AccelerationCurve : uint8_t
 {
-    INDEX_CURRENT,
-    INDEX_ALTERNATE,
-    INDEX_PREVIOUS,
-    INDEX_NEXT,
-    INDEX_MAX
+    CURVE_LINEAR,
+    CURVE_QUADRATIC, // Speed squared like the formula used before the table, sampled once per bucket
+    CURVE_EXPONENTIAL
 };
 
-enum DisplayMode : uint8_t
+// Firmware only, how an Effect turns its keyframe value into pixels.
+enum EffectType : uint8_t
 {
-    MODE_SPLASH,
-    MODE_OUTPUT,
-    MODE_INPUT,
-    MODE_APPLICATION,
-    MODE_GAME,
-    MODE_MAX
-};
\ No newline at end of file
+    EFFECT_TYPE_ROTATE,   // Every spacing-th pixel lit, the value rotates them around the ring
+    EFFECT_TYPE_PULSE,    // All pixels at the value's position in the colors
+    EFFECT_TYPE_GRADIENT, // Colors spread around the ring, the value rotates them
+    EFFECT_TYPE_BREATHE   // Colors spread around the ring, the value is their brightness
+};
+
+// Firmware only, where an Effect takes its colors from.
+enum EffectSource : uint8_t
+{
+    EFFECT_SOURCE_PALETTE, // Gradient between the two colors of the current mode
+    EFFECT_SOURCE_HUE,     // Hue wheel, turning by hueRate per ms
+    EFFECT_SOURCE_VOLUME   // Volume ring of the current session
+};
@@ -10,87 +10,276 @@
 //---------------------------------------------------------
 void UpdateLighting()
 {
-    if (g_DisplayAsleep)
+    SessionData *item = &g_Sessions[SessionIndex::INDEX_CURRENT];
+    bool mix = g_SessionInfo.mode == DisplayMode::MODE_GAME;
+    if (mix != g_PaletteMix)
     {
-        LightingBlackOut();
+        g_PaletteMix = mix;
+        BuildPalette();
     }
+
+    g_PixelsDithering = false;
+    if (g_DisplayAsleep)
+        LightingPlay(g_Settings.sleepEffect);
     else if (g_SessionInfo.mode == DisplayMode::MODE_SPLASH)
-    {
-        LightingCircularFunk();
-    }
-    else if (g_SessionInfo.mode == DisplayMode::MODE_GAME)
-    {
-        LightingVolume(&g_Sessions[SessionIndex::INDEX_CURRENT], &g_Settings.mixChannelAColor, &g_Settings.mixChannelBColor);
-    }
+        LightingPlay(g_Settings.splashEffect);
+    else if (item->data.isMuted)
+        LightingPlay(g_Settings.muteEffect);
     else
     {
-        LightingVolume(&g_Sessions[SessionIndex::INDEX_CURRENT], &g_Settings.volumeMinColor, &g_Settings.volumeMaxColor);
+        g_EffectPlaying = LightingEffect::EFFECT_MAX;
+        if (g_Now - g_PeakLevelsTime < PEAK_METER_TIMEOUT && g_Now - g_LastActivity >= PEAK_METER_DELAY)
+            LightingMeter(g_PeakLevels.Get(SessionIndex::INDEX_CURRENT));
+        else
+            LightingVolume(item);
     }
-    // Push the colors to the g_Pixels strip
-    g_Pixels.show();
+    g_PixelsFrame++;
+
+    // Pushed to the g_Pixels strip by ShowPixels(), while dithering every frame, otherwise only if it differs from the last one.
+    bool changed = g_PixelsDithering || memcmp(g_Pixels.getPixels(), g_PixelsShown, sizeof(g_PixelsShown)) != 0;
+    if (changed && !g_PixelsPending)
+        g_PixelsPendingSince = g_Now;
+    g_PixelsPending = changed;
 }
 
 //---------------------------------------------------------
-void LightingBlackOut()
+// \brief Pushes the pending frame right after a Timer1 tick, so the time
+// show() spends with interrupts off fits before the next one. When the next
+// tick is too close it waits for a later loop, unless it is already a frame late.
+//---------------------------------------------------------
+void ShowPixels()
 {
-    // All black
-    g_Pixels.clear();
+    if (!g_PixelsPending)
+        return;
+
+    cli();
+    uint32_t lastTick = g_LastTimerTick;
+    sei();
+    uint32_t start = micros();
+    if (start - lastTick + PIXELS_SHOW_TIME > TIMER_PERIOD && g_Now - g_PixelsPendingSince < PIXELS_UPDATE_INTERVAL)
+        return;
+
+    g_PixelsPending = false;
+    memcpy(g_PixelsShown, g_Pixels.getPixels(), sizeof(g_PixelsShown));
+    g_Pixels.show();
+    g_Diagnostics.pixelsShowMax = max(g_Diagnostics.pixelsShowMax, (uint16_t)min(micros() - start, 0xFFFFUL));
 }
 
 //---------------------------------------------------------
-void LightingCircularFunk()
+void LightingVolume(SessionData *item)
 {
-    uint32_t t = millis();
-    uint16_t hue = t * 20;
-    uint32_t rgbColor = g_Pixels.ColorHSV(hue);
+    // Dual colors circular lighting representing the volume.
+    for (uint8_t i = 0; i < PIXELS_COUNT; i++)
+        SetPixelDithered(i, VolumeColor(item, i));
+}
 
-    g_Pixels.clear();
-    for (uint8_t i = (t % 500) / 250; i < PIXELS_COUNT; i += 2)
+//---------------------------------------------------------
+// \brief VU meter, pixels light up in turn from the first to the second color.
+// \param level - [0..15] peak from the host
+//---------------------------------------------------------
+void LightingMeter(uint8_t level)
+{
+    g_MeterLevel = max(level * 17, g_MeterLevel - min(g_MeterLevel, PEAK_METER_FALLOFF));
+    int16_t levelAcc = g_MeterLevel * PIXELS_COUNT;
+    for (uint8_t i = 0; i < PIXELS_COUNT; i++)
     {
-        g_Pixels.setPixelColor(i, rgbColor);
+        uint8_t amp = constrain(levelAcc - i * 255, 0, 255);
+        PaletteColor c = g_Palette[(i * (PIXELS_PALETTE_SIZE - 1) + (PIXELS_COUNT - 1) / 2) / (PIXELS_COUNT - 1)];
+        SetPixelDithered(i, ScaleColor(c, amp));
     }
 }
 
 //---------------------------------------------------------
-void LightingVolume(SessionData *item, Color *c1, Color *c2)
+// \brief Nearest precomputed color for a pixel of the volume ring, each pixel
+// blends from the first to the second color over its share of the volume.
+//---------------------------------------------------------
+const PaletteColor &VolumeColor(SessionData *item, uint8_t pixel)
+{
+    int16_t amp = ((uint32_t)item->data.volume * 255 * PIXELS_COUNT) / 100 - pixel * 255;
+    amp = constrain(amp, 0, 255);
+    return g_Palette[(amp + (1 << PIXELS_PALETTE_SHIFT) / 2) >> PIXELS_PALETTE_SHIFT];
+}
+
+//---------------------------------------------------------
+// \brief Lighting effects, indexed by LightingEffect.
+//---------------------------------------------------------
+static const Effect EFFECTS[LightingEffect::EFFECT_MAX] PROGMEM = {
+    // EFFECT_OFF
+    {EFFECT_TYPE_BREATHE, EFFECT_SOURCE_PALETTE, 1000, false, 0, 0, 1, {{0, 0}}},
+    // EFFECT_PULSE, triangle wave between the two colors every second.
+    {EFFECT_TYPE_PULSE, EFFECT_SOURCE_PALETTE, 1000, true, 0, 0, 3, {{0, 0}, {128, 255}, {255, 0}}},
+    // EFFECT_BREATHE, holds a moment at full brightness.
+    {EFFECT_TYPE_BREATHE, EFFECT_SOURCE_PALETTE, 4000, true, 0, 0, 4, {{0, 16}, {96, 255}, {160, 255}, {255, 16}}},
+    // EFFECT_SPIN, steps by one pixel every 250ms.
+    {EFFECT_TYPE_ROTATE, EFFECT_SOURCE_HUE, 500, true, 2, 20, 4, {{0, 0}, {127, 0}, {128, 256 / PIXELS_COUNT}, {255, 256 / PIXELS_COUNT}}},
+    // EFFECT_RAINBOW
+    {EFFECT_TYPE_GRADIENT, EFFECT_SOURCE_HUE, 3000, true, 0, 0, 2, {{0, 0}, {255, 255}}},
+    // EFFECT_FADE_OUT
+    {EFFECT_TYPE_BREATHE, EFFECT_SOURCE_VOLUME, 1000, false, 0, 0, 2, {{0, 255}, {255, 0}}},
+};
+
+//---------------------------------------------------------
+// \brief Renders a frame of a lighting effect. It starts over when a
+// different one is played, effects that don't loop then hold their end.
+//---------------------------------------------------------
+void LightingPlay(LightingEffect id)
 {
-    if (!item->data.isMuted)
+    // Settings come from the host, anything unknown is off.
+    if (id >= LightingEffect::EFFECT_MAX)
+        id = LightingEffect::EFFECT_OFF;
+    if (id != g_EffectPlaying)
     {
-        // Dual colors circular lighting representing the volume.
-        uint32_t volAcc = ((uint32_t)item->data.volume * 255 * PIXELS_COUNT) / 100;
-        for (int i = 0; i < PIXELS_COUNT; i++)
-        {
-            uint32_t amp = min(volAcc, 255);
-            volAcc -= amp;
+        g_EffectPlaying = id;
+        g_EffectStart = g_Now;
+    }
+
+    Effect effect;
+    memcpy_P(&effect, &EFFECTS[id], sizeof(Effect));
+
+    uint32_t elapsed = g_Now - g_EffectStart;
+    uint16_t hue = elapsed * effect.hueRate;
+    // Effects that don't loop hold their end, elapsed * 256 would wrap after a few hours and replay them.
+    if (effect.loop)
+        elapsed %= effect.period;
+    else
+        elapsed = min(elapsed, (uint32_t)effect.period);
+    uint8_t value = EffectValue(effect, min(elapsed * 256 / effect.period, 255));
 
-            // Linear interpolation to get the final color of each pixel.
-            Color c = LerpColor(c1, c2, amp);
-            g_Pixels.setPixelColor(i, c.r, c.g, c.b);
+    for (uint8_t i = 0; i < PIXELS_COUNT; i++)
+    {
+        uint8_t position = i * (256 / PIXELS_COUNT);
+        uint8_t brightness = 255;
+        if (effect.type == EFFECT_TYPE_ROTATE)
+        {
+            uint8_t offset = ((uint16_t)value * PIXELS_COUNT) >> 8;
+            position = 0;
+            if ((i + PIXELS_COUNT - offset) % effect.spacing != 0)
+                brightness = 0;
         }
+        else if (effect.type == EFFECT_TYPE_PULSE)
+            position = value;
+        else if (effect.type == EFFECT_TYPE_GRADIENT)
+            position += value;
+        else if (effect.type == EFFECT_TYPE_BREATHE)
+            brightness = value;
+
+        PaletteColor c = EffectColor(effect.source, i, position, hue);
+        SetPixelDithered(i, brightness != 255 ? ScaleColor(c, brightness) : c);
     }
-    else
+}
+
+//---------------------------------------------------------
+// \brief Interpolates the keyframes of an effect.
+// \param phase - [0..255] over the effect period
+//---------------------------------------------------------
+uint8_t EffectValue(const Effect &effect, uint8_t phase)
+{
+    const EffectKeyframe *keys = effect.keyframes;
+    uint8_t i = 0;
+    while (i + 1 < effect.keyframesCount && keys[i + 1].time <= phase)
+        i++;
+    if (i + 1 >= effect.keyframesCount || phase < keys[i].time)
+        return keys[i].value;
+
+    int16_t delta = keys[i + 1].value - keys[i].value;
+    return keys[i].value + delta * (phase - keys[i].time) / (keys[i + 1].time - keys[i].time);
+}
+
+//---------------------------------------------------------
+// \param position - [0..255] along the palette gradient or the hue wheel
+// \param hue - start of the hue wheel
+//---------------------------------------------------------
+PaletteColor EffectColor(EffectSource source, uint8_t pixel, uint8_t position, uint16_t hue)
+{
+    if (source == EFFECT_SOURCE_HUE)
     {
-        // Fast pulse between the first and second color.
-        // Both 't' and 'period' need to be signed for the formula to work.
-        int32_t t = millis();
-        int32_t period = 500;
-        uint8_t amp = (period - abs(t % (2 * period) - period)) * 255 / period; // Triangular wave
-
-        Color c = LerpColor(c1, c2, amp);
-        uint32_t color32 = ((uint32_t)c.r << 16) | ((uint32_t)c.g << 8) | (uint32_t)c.b;
-        g_Pixels.fill(color32);
+        uint32_t rgb = g_Pixels.ColorHSV(hue + ((uint16_t)position << 8));
+        return {Dim(rgb >> 16), Dim(rgb >> 8), Dim(rgb)};
     }
+    if (source == EFFECT_SOURCE_VOLUME)
+        return VolumeColor(&g_Sessions[SessionIndex::INDEX_CURRENT], pixel);
+    return g_Palette[(position + (1 << PIXELS_PALETTE_SHIFT) / 2) >> PIXELS_PALETTE_SHIFT];
+}
+
+//---------------------------------------------------------
+// \brief Frame counter with its 4 bits reversed, scaled to 0..255. Consecutive frames get
+// thresholds far apart, so a fraction is spread evenly instead of in a slow one step blink.
+//---------------------------------------------------------
+static const uint8_t PROGMEM DITHER_THRESHOLDS[] = {0, 128, 64, 192, 32, 160, 96, 224, 16, 144, 80, 208, 48, 176, 112, 240};
+
+//---------------------------------------------------------
+// \brief Fraction of a channel in dithering steps, 0 when every frame of the sequence rounds it the same way.
+//---------------------------------------------------------
+static inline uint8_t DitherFraction(uint16_t channel)
+{
+    return (((channel & 0xFF) + (128 >> PIXELS_DITHER_BITS)) >> (8 - PIXELS_DITHER_BITS)) & ((1 << PIXELS_DITHER_BITS) - 1);
 }
 
 //---------------------------------------------------------
-Color LerpColor(Color *c1, Color *c2, uint8_t coeff)
+// \brief Sets a pixel to a palette color, rounding each channel up on a share of the
+// frames equal to its fraction. Pixels are offset in the sequence so they don't flicker in sync.
+//---------------------------------------------------------
+void SetPixelDithered(uint8_t i, const PaletteColor &c)
 {
+    g_PixelsDithering |= DitherFraction(c.r) | DitherFraction(c.g) | DitherFraction(c.b);
 
-    SQ15x16 amount = SQ15x16(coeff) / 255;
-    SQ15x16 invAmount = 1 - amount;
-    uint8_t r = ((invAmount * c1->r) + (amount * c2->r)).getInteger();
-    uint8_t g = ((invAmount * c1->g) + (amount * c2->g)).getInteger();
-    uint8_t b = ((invAmount * c1->b) + (amount * c2->b)).getInteger();
+    uint8_t step = (g_PixelsFrame + i) & ((1 << PIXELS_DITHER_BITS) - 1);
+    uint8_t threshold = pgm_read_byte(&DITHER_THRESHOLDS[step]) + (128 >> PIXELS_DITHER_BITS);
+    g_Pixels.setPixelColor(i, (c.r + threshold) >> 8, (c.g + threshold) >> 8, (c.b + threshold) >> 8);
+}
 
-    return {r, g, b};
+//---------------------------------------------------------
+// \param amount - [0..255] where 255 is just under the full color
+//---------------------------------------------------------
+PaletteColor &ScaleColor(PaletteColor &c, uint8_t amount)
+{
+    c.r = ((uint32_t)c.r * amount) >> 8;
+    c.g = ((uint32_t)c.g * amount) >> 8;
+    c.b = ((uint32_t)c.b * amount) >> 8;
+    return c;
 }
+
+//---------------------------------------------------------
+// \brief Precomputes the gradient LightingVolume() picks from, call when g_Settings or g_PaletteMix change.
+//---------------------------------------------------------
+void BuildPalette()
+{
+    const Color &c1 = g_PaletteMix ? g_Settings.mixChannelAColor : g_Settings.volumeMinColor;
+    const Color &c2 = g_PaletteMix ? g_Settings.mixChannelBColor : g_Settings.volumeMaxColor;
+    for (uint8_t i = 0; i < PIXELS_PALETTE_SIZE; i++)
+    {
+        uint8_t t = min(i << PIXELS_PALETTE_SHIFT, 255);
+        g_Palette[i].r = BlendChannel(c1.r, c2.r, t);
+        g_Palette[i].g = BlendChannel(c1.g, c2.g, t);
+        g_Palette[i].b = BlendChannel(c1.b, c2.b, t);
+    }
+}
+
+//---------------------------------------------------------
+// \brief Blends two channels by t / 255 and applies gamma and PIXELS_BRIGHTNESS,
+// keeping 8 fractional bits along the way.
+//---------------------------------------------------------
+uint16_t BlendChannel(uint8_t a, uint8_t b, uint8_t t)
+{
+    // x / 255 in 8.8 is close enough to x + x / 256.
+    uint16_t x = (uint16_t)a * (255 - t) + (uint16_t)b * t;
+    x += x >> 8;
+
+    // Linear between the neighbouring gamma8() entries.
+    uint8_t xi = x >> 8;
+    uint8_t g0 = Adafruit_NeoPixel::gamma8(xi);
+    uint8_t g1 = Adafruit_NeoPixel::gamma8(min(xi + 1, 255));
+    uint16_t g = ((uint16_t)g0 << 8) + (uint16_t)(g1 - g0) * (x & 0xFF);
+
+    return ((uint32_t)g * (PIXELS_BRIGHTNESS + 1)) >> 8;
+}
+
+//---------------------------------------------------------
+// \brief Scales a channel by PIXELS_BRIGHTNESS, same as Adafruit_NeoPixel::setBrightness()
+// but keeping 8 fractional bits for SetPixelDithered().
+//---------------------------------------------------------
+uint16_t Dim(uint8_t value)
+{
+    return (uint16_t)value * (PIXELS_BRIGHTNESS + 1);
+}
+
@@ -17,6 +17,7 @@
 #include "Config.h"
 #include "Display.h"
 #include "Communications.h"
+#include "RingBuffer.h"
 
 // Third-party
 #include "src/Adafruit_GFX/Adafruit_GFX.h"
@@ -36,40 +37,146 @@ SessionData g_Sessions[SessionIndex::INDEX_MAX];
 ModeStates g_ModeStates;
 uint8_t g_DisplayDirty;
 bool g_DisplayAsleep;
+// Since boot, sent with Command::DIAGNOSTICS.
+Diagnostics g_Diagnostics;
+// Streamed by the host while it has audio meters, see PEAK_METER_TIMEOUT.
+PeakLevels g_PeakLevels;
+uint32_t g_PeakLevelsTime;
 
 // Encoder Button
 ButtonEvents g_EncoderButton;
-volatile ButtonEvent g_ButtonEvent;
+// Set on a first press, a release that follows is an early tap.
+bool g_ButtonTapCandidate;
+// Mode an early tap was applied in, MODE_MAX if none, and its mode state before the tap.
+DisplayMode g_EarlyTapMode;
+uint8_t g_EarlyTapState;
 
 // Rotary Encoder
 Rotary g_Encoder(PIN_ENCODER_OUTB, PIN_ENCODER_OUTA);
 int8_t g_PreviousSteps;
-volatile int8_t g_EncoderSteps;
+uint16_t g_LastDetent;
+uint16_t g_DetentInterval;
+// Volume step per detent interval bucket, rebuilt when the acceleration setting changes.
+uint8_t g_AccelerationTable[ROTARY_ACCELERATION_BUCKETS];
+uint8_t g_AccelerationPercentage;
+// Last pins read, (A << 1) | B.
+uint8_t g_EncoderPins;
+#if defined(ENCODER_PCINT_vect)
+volatile uint8_t *g_EncoderPort;
+uint8_t g_EncoderMaskA;
+uint8_t g_EncoderMaskB;
+#endif
+
+// Input
+// Pushed by the encoder and timer interrupts, which never nest so they act as a single producer.
+// Timestamped there so acceleration and button handling follow the user, not the loop duration.
+RingBuffer<InputEvent, INPUT_EVENTS_SIZE> g_InputEvents;
+// Net encoder steps among the events that didn't fit, still applied so no rotation is lost.
+volatile int8_t g_EncoderStepsLost;
 
 // Time & Sleep
 uint32_t g_Now;
+uint32_t g_LastTimerTick; // micros()
 uint32_t g_HeartbeatTimeout;
 uint32_t g_LastActivity;
 uint32_t g_NextPixelUpdate;
-uint32_t g_LastSteps;
+uint32_t g_PixelsPendingSince; // Frame waiting for a gap between Timer1 ticks, see ShowPixels().
+bool g_PixelsPending;
+uint8_t g_PixelsShown[PIXELS_COUNT * 3]; // Last frame pushed, an identical frame isn't pushed again.
 
 // Lighting
-Adafruit_NeoPixel g_Pixels(PIXELS_COUNT, PIN_PIXELS, NEO_GRB + NEO_KHZ800);
+// Buffer stored inline instead of malloc'd, counted with the globals and nothing on the heap.
+Adafruit_NeoPixelStatic<PIXELS_COUNT, NEO_GRB + NEO_KHZ800> g_Pixels(PIN_PIXELS);
+// Gradient of the current mode, gamma and PIXELS_BRIGHTNESS already applied. Rebuilt from g_Settings.
+PaletteColor g_Palette[PIXELS_PALETTE_SIZE];
+bool g_PaletteMix; // g_Palette holds the game mode colors.
+uint8_t g_PixelsFrame; // Position in the dithering sequence.
+bool g_PixelsDithering; // A pixel of the frame has a fraction the dithering shows, see SetPixelDithered().
+LightingEffect g_EffectPlaying = LightingEffect::EFFECT_MAX; // EFFECT_MAX while showing the volume.
+uint32_t g_EffectStart;
+uint8_t g_MeterLevel; // [0..255] as shown, falls off slower than the peaks.
+uint8_t g_PeakMeterShown; // Peak meter level on the edit screens, see UpdatePeakMeter().
+uint32_t g_NextMeterUpdate;
 
 //********************************************************
 // *** INTERRUPTS
 //********************************************************
-void timerIsr()
+void PushInputEvent(InputEventType type)
 {
-    uint8_t encoderDir = g_Encoder.process();
+    InputEvent event;
+    event.time = millis();
+    event.type = type;
+    if (g_InputEvents.Push(event))
+        return;
+
+    g_Diagnostics.inputOverflows++;
+    if (type == InputEventType::INPUT_STEP_CW)
+        g_EncoderStepsLost++;
+    else if (type == InputEventType::INPUT_STEP_CCW)
+        g_EncoderStepsLost--;
+}
+
+void EncoderIsr(uint8_t pins)
+{
+    // Both pins changing between two samples means a quadrature state went by unseen.
+    if ((pins ^ g_EncoderPins) == 3)
+        g_Diagnostics.encoderInvalid++;
+    g_EncoderPins = pins;
+
+    uint8_t encoderDir = g_Encoder.process(pins);
     if (encoderDir == DIR_CW)
-        g_EncoderSteps++;
+        PushInputEvent(InputEventType::INPUT_STEP_CW);
     else if (encoderDir == DIR_CCW)
-        g_EncoderSteps--;
+        PushInputEvent(InputEventType::INPUT_STEP_CCW);
+}
+
+#if defined(ENCODER_PCINT_vect)
+ISR(ENCODER_PCINT_vect)
+{
+    // Same pin order as Rotary::process(), (A << 1) | B.
+    uint8_t pins = *g_EncoderPort;
+    EncoderIsr(((pins & g_EncoderMaskA) ? 2 : 0) | ((pins & g_EncoderMaskB) ? 1 : 0));
+}
+#endif
+
+void timerIsr()
+{
+    // A tick held back by disabled interrupts runs late, ticks due meanwhile are lost.
+    uint32_t now = micros();
+    uint32_t interval = now - g_LastTimerTick;
+    g_LastTimerTick = now;
+    if (interval > TIMER_PERIOD)
+    {
+        g_Diagnostics.timerLateMax = max(g_Diagnostics.timerLateMax, (uint16_t)min(interval - TIMER_PERIOD, 0xFFFFUL));
+        g_Diagnostics.timerMissed += (interval + TIMER_PERIOD / 2) / TIMER_PERIOD - 1;
+    }
+
+#if !defined(ENCODER_PCINT_vect)
+    EncoderIsr((digitalRead(PIN_ENCODER_OUTA) << 1) | digitalRead(PIN_ENCODER_OUTB));
+#endif
 
-    if (g_ButtonEvent == none && g_EncoderButton.update())
+    if (g_EncoderButton.update())
     {
-        g_ButtonEvent = g_EncoderButton.event();
+        ButtonEvent buttonEvent = g_EncoderButton.event();
+        if (buttonEvent == ButtonEvent::tap)
+        {
+            PushInputEvent(InputEventType::INPUT_TAP);
+        }
+        else if (buttonEvent == ButtonEvent::doubleTap || buttonEvent == ButtonEvent::hold)
+        {
+            g_ButtonTapCandidate = false;
+            PushInputEvent(buttonEvent == ButtonEvent::doubleTap ? InputEventType::INPUT_DOUBLE_TAP : InputEventType::INPUT_HOLD);
+        }
+        // Button is active low, a second press reports doubleTap above instead of falling here.
+        else if (g_EncoderButton.fell())
+        {
+            g_ButtonTapCandidate = true;
+        }
+        else if (g_EncoderButton.rose() && g_ButtonTapCandidate)
+        {
+            g_ButtonTapCandidate = false;
+            PushInputEvent(InputEventType::INPUT_RELEASE);
+        }
     }
 }
 
@@ -86,7 +193,7 @@ void setup()
     Communications::Initialize();
 
     //--- Pixels
-    g_Pixels.setBrightness(PIXELS_BRIGHTNESS);
+    // No setBrightness(), PIXELS_BRIGHTNESS is applied when the colors are computed.
     g_Pixels.begin();
     g_Pixels.show();
 
@@ -99,7 +206,17 @@ void setup()
     g_EncoderButton.attach(PIN_ENCODER_SWITCH);
     g_EncoderButton.debounceTime(15);
     g_Encoder.begin(true);
-    Timer1.initialize(1000);
+    g_EncoderPins = (digitalRead(PIN_ENCODER_OUTA) << 1) | digitalRead(PIN_ENCODER_OUTB);
+#if defined(ENCODER_PCINT_vect)
+    g_EncoderPort = portInputRegister(digitalPinToPort(PIN_ENCODER_OUTA));
+    g_EncoderMaskA = digitalPinToBitMask(PIN_ENCODER_OUTA);
+    g_EncoderMaskB = digitalPinToBitMask(PIN_ENCODER_OUTB);
+    *digitalPinToPCMSK(PIN_ENCODER_OUTA) |= _BV(digitalPinToPCMSKbit(PIN_ENCODER_OUTA));
+    *digitalPinToPCMSK(PIN_ENCODER_OUTB) |= _BV(digitalPinToPCMSKbit(PIN_ENCODER_OUTB));
+    *digitalPinToPCICR(PIN_ENCODER_OUTA) |= _BV(digitalPinToPCICRbit(PIN_ENCODER_OUTA));
+#endif
+    Timer1.initialize(TIMER_PERIOD);
+    g_LastTimerTick = micros();
     Timer1.attachInterrupt(timerIsr);
 }
 
@@ -111,10 +228,17 @@ void loop()
     g_Now = millis();
 
     Command command = Communications::Read();
+    if (command == Command::SETTINGS)
+    {
+        if (g_Settings.accelerationPercentage != g_AccelerationPercentage)
+            BuildAccelerationTable(ROTARY_ACCELERATION_CURVE, g_Settings.accelerationPercentage);
+        BuildPalette();
+    }
+
     // Returns the type of message we recieved, update oled if we recieved data that impacts what is currently on display
     // This should really depend on a few things, like setings of continious scroll, vs new item index vs count, etc.
     // for now lets be safe and check for any command that impacts a stored value, we can fine tune this later
-    g_DisplayDirty = (command >= Command::SETTINGS || command <= Command::VOLUME_ALT_CHANGE);
+    g_DisplayDirty |= (command >= Command::SETTINGS && command <= Command::MODE_STATES);
     if (command == Command::CURRENT_SESSION || command == Command::ALTERNATE_SESSION ||
         command == Command::VOLUME_CURR_CHANGE || command == Command::VOLUME_ALT_CHANGE)
     {
@@ -122,17 +246,12 @@ void loop()
         g_DisplayDirty = true;
     }
 
-    if (ProcessEncoderRotation())
-    {
-        g_LastActivity = g_Now;
-        g_DisplayDirty = true;
-    }
-
-    if (ProcessEncoderButton())
+    if (ProcessInputEvents())
     {
         g_LastActivity = g_Now;
         g_DisplayDirty = true;
     }
+    Communications::Update();
 
     if (ProcessSleep())
     {
@@ -141,8 +260,15 @@ void loop()
 
     if (g_DisplayDirty || ProcessDisplayScroll())
     {
+        g_PeakMeterShown = GetPeakMeterLevel();
+        Display::SetPeakMeter(g_PeakMeterShown);
         UpdateDisplay();
     }
+    else if (g_Now - g_NextMeterUpdate < 0x80000000U)
+    {
+        g_NextMeterUpdate = g_Now + DISPLAY_METER_INTERVAL;
+        UpdatePeakMeter();
+    }
 
     Display::UpdateTimers(g_Now - last);
     g_DisplayDirty = false;
@@ -150,9 +276,10 @@ void loop()
     // Update Lighting at 30Hz
     if (g_Now - g_NextPixelUpdate < 0x80000000U)
     {
-        g_NextPixelUpdate = g_Now + 33;
+        g_NextPixelUpdate = g_Now + PIXELS_UPDATE_INTERVAL;
         UpdateLighting();
     }
+    ShowPixels();
 
     // Reset / Disconnect if no serial activity.
     if ((g_SessionInfo.mode != DisplayMode::MODE_SPLASH) && (g_Now - g_HeartbeatTimeout < 0x80000000U))
@@ -173,30 +300,116 @@ void ResetState()
     g_ModeStates = ModeStates();
     g_DisplayDirty = true;
     g_DisplayAsleep = false;
+    Communications::Reset();
 
     // Encoder Button
-    g_ButtonEvent = ButtonEvent::none;
+    g_EarlyTapMode = DisplayMode::MODE_MAX;
 
     // Rotary Encoder
     g_PreviousSteps = 0;
-    g_EncoderSteps = 0;
+    g_DetentInterval = ROTARY_VELOCITY_RESET;
+    BuildAccelerationTable(ROTARY_ACCELERATION_CURVE, g_Settings.accelerationPercentage);
+
+    // Input
+    g_InputEvents.Clear();
+    g_EncoderStepsLost = 0;
 
     // Time & Sleep
     g_Now = millis();
     g_HeartbeatTimeout = 0;
     g_LastActivity = g_Now;
     g_NextPixelUpdate = 0;
-    g_LastSteps = 0;
+    g_PixelsPending = false;
+    g_EffectPlaying = LightingEffect::EFFECT_MAX;
+    g_PeakLevelsTime = g_Now - PEAK_METER_TIMEOUT;
+    BuildPalette();
+    g_LastDetent = g_Now;
+}
+
+//---------------------------------------------------------
+// \brief Maps a detent interval to its acceleration table entry.
+// Below 16ms every ms has its own bucket, above that each power of two is
+// split in 8 so a bucket never spans more than 12.5% of speed.
+// \param interval - time between detents (ms)
+//---------------------------------------------------------
+uint8_t GetAccelerationBucket(uint16_t interval)
+{
+    if (interval < 16)
+        return interval;
+    if (interval > 255)
+        interval = 255;
+
+    uint8_t exponent = 4;
+    while (interval >> (exponent + 1))
+        exponent++;
+    return 16 + (exponent - 4) * 8 + ((interval >> (exponent - 3)) & 7);
+}
+
+//---------------------------------------------------------
+// \brief Precomputes the volume step of each detent interval bucket so the
+// encoder path is a lookup instead of fixed point maths.
+// \param curve - how the step grows with speed
+// \param percentage - acceleration setting
+//---------------------------------------------------------
+void BuildAccelerationTable(AccelerationCurve curve, uint8_t percentage)
+{
+    // (1 - percentage / 100) * ROTARY_ACCELERATION_DIVISOR_MAX, percentage can go past 100.
+    int32_t divisor = max((int32_t)(100 - percentage) * ROTARY_ACCELERATION_DIVISOR_MAX / 100, 1);
+    // The same in SQ15x16 as ComputeAcceleratedVolume() used to, the quadratic curve rounds like it did.
+    SQ15x16 quadraticDivisor = max((1 - (SQ15x16)percentage / 100) * ROTARY_ACCELERATION_DIVISOR_MAX, 1);
+    uint32_t reference = ROTARY_ACCELERATION_REFERENCE;
+
+    for (uint8_t i = 0; i < ROTARY_ACCELERATION_BUCKETS; i++)
+    {
+        // Middle of the bucket, in half ms per detent.
+        uint32_t interval = max(i * 2, 2);
+        if (i >= 16)
+        {
+            uint8_t shift = (i - 16) / 8 + 1;
+            interval = ((8 + (i & 7)) << (shift + 1)) + (1 << shift) - 1;
+        }
+
+        uint32_t step;
+        if (curve == AccelerationCurve::CURVE_LINEAR)
+        {
+            // speed * reference / divisor
+            step = 2000 * reference / (interval * divisor);
+        }
+        else if (curve == AccelerationCurve::CURVE_EXPONENTIAL)
+        {
+            // reference^2 / divisor * (2^(speed / reference) - 1)
+            // 2^x is approximated as 2^n * (1 + fraction) in 8.8 fixed point, past 2^8 any setting hits the max.
+            uint32_t x = 512000 / (interval * reference);
+            uint8_t n = x >> 8;
+            if (n >= 8)
+                step = ROTARY_ACCELERATION_STEP_MAX;
+            else
+                step = reference * reference * (((256 + (x & 0xFF)) << n) - 256) / (divisor * 256);
+        }
+        else if (interval < 12)
+        {
+            // Under 6ms speed^2 doesn't fit SQ15x16, the step is past the max for any setting anyway.
+            step = ROTARY_ACCELERATION_STEP_MAX;
+        }
+        else
+        {
+            // speed^2 / divisor, 1ms buckets give exactly the steps of the old formula.
+            SQ15x16 speed = (SQ15x16)2000 / interval;
+            step = absFixed(speed * speed / quadraticDivisor).getInteger();
+        }
+        g_AccelerationTable[i] = min(step + 1, (uint32_t)ROTARY_ACCELERATION_STEP_MAX);
+    }
+    g_AccelerationPercentage = percentage;
 }
 
 //---------------------------------------------------------
-// \brief Encoder acceleration algorithm (Exponential - speed squared)
-// \param encoderDelta - step difference since last check
-// \param deltaTime - time difference since last check (ms)
+// \brief Encoder acceleration, the step grows with speed along ROTARY_ACCELERATION_CURVE.
+// \param encoderDelta - detent direction
+// \param deltaTime - time since the previous detent (ms)
 // \param volume - curent volume
 // \returns new adjusted volume
 //---------------------------------------------------------
-int8_t ComputeAcceleratedVolume(int8_t encoderDelta, uint32_t deltaTime, int16_t volume)
+int8_t ComputeAcceleratedVolume(int8_t encoderDelta, uint16_t deltaTime, int16_t volume)
 {
     if (encoderDelta == 0)
         return volume;
@@ -204,15 +417,9 @@ int8_t ComputeAcceleratedVolume(int8_t encoderDelta, uint32_t deltaTime, int16_t
     // Test the top bit (negative bit) for direction changed
     bool dirChanged = (g_PreviousSteps & 0x80) != (encoderDelta & 0x80);
 
-    uint32_t step = 1;
+    uint8_t step = 1;
     if (!dirChanged)
-    {
-        // Compute acceleration using fixed point maths.
-        SQ15x16 speed = (SQ15x16)encoderDelta * 1000 / deltaTime;
-        SQ15x16 accelerationDivisor = max((1 - (SQ15x16)g_Settings.accelerationPercentage / 100) * ROTARY_ACCELERATION_DIVISOR_MAX, 1);
-        SQ15x16 fstep = 1 + absFixed(speed * speed / accelerationDivisor);
-        step = fstep.getInteger();
-    }
+        step = g_AccelerationTable[GetAccelerationBucket(deltaTime)];
 
     g_PreviousSteps = encoderDelta;
 
@@ -276,50 +483,122 @@ uint8_t GetIndexForMode(DisplayMode mode)
 
 //---------------------------------------------------------
 //---------------------------------------------------------
-void ComputeVolumeChange(int8_t index, int8_t encoderSteps, uint32_t deltaTime)
+// \brief Tracks the time between detents, smoothed over consecutive ones.
+// \param time - detent timestamp (ms)
+// \returns interval to compute the speed from (ms)
+//---------------------------------------------------------
+uint16_t UpdateDetentInterval(uint16_t time)
+{
+    uint16_t interval = time - g_LastDetent;
+    g_LastDetent = time;
+    if (interval >= ROTARY_VELOCITY_RESET)
+        g_DetentInterval = ROTARY_VELOCITY_RESET;
+    else
+        g_DetentInterval = max((g_DetentInterval + interval + 1) / 2, 1);
+    return g_DetentInterval;
+}
+
+//---------------------------------------------------------
+//---------------------------------------------------------
+int8_t GetStepDirection(const InputEvent &step)
+{
+    return step.type == InputEventType::INPUT_STEP_CW ? 1 : -1;
+}
+
+//---------------------------------------------------------
+//---------------------------------------------------------
+void ComputeVolumeChange(int8_t index, const InputEvent *steps, uint8_t count, int8_t lost)
 {
     uint8_t prev = g_Sessions[index].data.volume;
-    g_Sessions[index].data.volume = ComputeAcceleratedVolume(encoderSteps, deltaTime, prev);
+    int8_t volume = prev;
+    // Each detent accelerates with its own speed.
+    for (uint8_t i = 0; i < count; i++)
+        volume = ComputeAcceleratedVolume(GetStepDirection(steps[i]), UpdateDetentInterval(steps[i].time), volume);
+    // Detents that didn't fit in the ring keep the last speed.
+    for (; lost != 0; lost -= lost > 0 ? 1 : -1)
+        volume = ComputeAcceleratedVolume(lost > 0 ? 1 : -1, g_DetentInterval, volume);
+
+    g_Sessions[index].data.volume = volume;
     if (prev != g_Sessions[index].data.volume)
-        Communications::Write((Command)(Command::VOLUME_CURR_CHANGE + index));
+        Communications::WriteVolume((SessionIndex)index);
 }
 
-bool ProcessEncoderRotation()
+//---------------------------------------------------------
+// \brief Drains the input events in order. Consecutive encoder steps are
+// handled together, so one loop sends at most one volume change per run.
+// \returns true if any event counts as user activity
+//---------------------------------------------------------
+bool ProcessInputEvents()
 {
-    int8_t encoderSteps = 0;
+    bool activity = false;
+    InputEvent steps[INPUT_EVENTS_SIZE];
+    uint8_t count = 0;
+    InputEvent event;
+    // Bounded so a busy encoder can't hold the loop.
+    for (uint8_t i = 0; i < INPUT_EVENTS_SIZE && g_InputEvents.Pop(event); i++)
+    {
+        if (event.type == InputEventType::INPUT_STEP_CW || event.type == InputEventType::INPUT_STEP_CCW)
+        {
+            steps[count++] = event;
+            continue;
+        }
+
+        if (count > 0)
+        {
+            activity |= ProcessEncoderRotation(steps, count, 0);
+            count = 0;
+        }
+        activity |= ProcessEncoderButton(event.type);
+    }
+
     cli();
-    encoderSteps = g_EncoderSteps;
-    g_EncoderSteps = 0;
+    int8_t lost = g_EncoderStepsLost;
+    g_EncoderStepsLost = 0;
     sei();
 
-    if (encoderSteps == 0)
-        return false;
+    if (count > 0 || lost != 0)
+        activity |= ProcessEncoderRotation(steps, count, lost);
+    return activity;
+}
 
-    uint32_t deltaTime = g_Now - g_LastSteps;
-    g_LastSteps = g_Now;
+//---------------------------------------------------------
+//---------------------------------------------------------
+bool ProcessEncoderRotation(const InputEvent *steps, uint8_t count, int8_t lost)
+{
+    int8_t encoderSteps = lost;
+    for (uint8_t i = 0; i < count; i++)
+        encoderSteps += GetStepDirection(steps[i]);
+
+    bool inGameMode = g_SessionInfo.mode == DisplayMode::MODE_GAME;
+    bool isEditing = (inGameMode && g_ModeStates.states[g_SessionInfo.mode] == STATE_GAME_EDIT) || (!inGameMode && g_ModeStates.states[g_SessionInfo.mode] == STATE_EDIT);
+    if (g_DisplayAsleep || g_SessionInfo.mode == DisplayMode::MODE_SPLASH || !isEditing)
+    {
+        // Keep the detent timing current for when editing starts.
+        if (count > 0)
+            UpdateDetentInterval(steps[count - 1].time);
+    }
 
     if (g_DisplayAsleep || g_SessionInfo.mode == DisplayMode::MODE_SPLASH)
         return true;
 
-    bool inGameMode = g_SessionInfo.mode == DisplayMode::MODE_GAME;
-    if ((inGameMode && g_ModeStates.states[g_SessionInfo.mode] == STATE_GAME_EDIT) || (!inGameMode && g_ModeStates.states[g_SessionInfo.mode] == STATE_EDIT))
+    if (isEditing)
     {
         if (!inGameMode)
         {
-            ComputeVolumeChange(SessionIndex::INDEX_CURRENT, encoderSteps, deltaTime);
+            ComputeVolumeChange(SessionIndex::INDEX_CURRENT, steps, count, lost);
         }
         else
         {
             // NOTES: Game mode works by selecting 2 sessions, to make things simpler for all "NAVIGATE" logic, CURRENT_SESSION/INDEX_CURRENT sould always be what we work with
             // and when we "select" a session for A, we copy it into ALTERNATE_SESSION/INDEX_ALTERNATE. We could simplify this logic by swapping INDEX_CURRENT & INDEX_ALTERNATE after B is selected,
             // but that just makes for a very messy logic for the App to keep PREVIOUS/NEXT/CURRENT logic in order. So lets just reverse it here so A = INDEX_ALTERNATE, B = INDEX_CURRENT
-            ComputeVolumeChange(SessionIndex::INDEX_ALTERNATE, encoderSteps, deltaTime);
+            ComputeVolumeChange(SessionIndex::INDEX_ALTERNATE, steps, count, lost);
             if (g_Sessions[SessionIndex::INDEX_ALTERNATE].data.id != g_Sessions[SessionIndex::INDEX_CURRENT].data.id)
             {
                 uint8_t prev = g_Sessions[SessionIndex::INDEX_CURRENT].data.volume;
                 g_Sessions[SessionIndex::INDEX_CURRENT].data.volume = 100 - g_Sessions[SessionIndex::INDEX_ALTERNATE].data.volume;
                 if (prev != g_Sessions[SessionIndex::INDEX_CURRENT].data.volume)
-                    Communications::Write(Command::VOLUME_CURR_CHANGE);
+                    Communications::WriteVolume(SessionIndex::INDEX_CURRENT);
             }
             else
                 g_Sessions[SessionIndex::INDEX_CURRENT].data.volume = g_Sessions[SessionIndex::INDEX_ALTERNATE].data.volume;
@@ -329,7 +608,7 @@ bool ProcessEncoderRotation()
     {
         if (encoderSteps > 0)
             NextSession();
-        else
+        else if (encoderSteps < 0)
             PreviousSession();
         Display::ResetTimers();
     }
@@ -339,21 +618,39 @@ bool ProcessEncoderRotation()
 
 //---------------------------------------------------------
 //---------------------------------------------------------
-bool ProcessEncoderButton()
+void ToggleModeState(void)
 {
-    ButtonEvent readButtonEvent = none;
-    cli();
-    readButtonEvent = g_ButtonEvent;
-    g_ButtonEvent = none;
-    sei();
+    g_ModeStates.states[g_SessionInfo.mode] = (g_ModeStates.states[g_SessionInfo.mode] + 1) % (g_SessionInfo.mode != DisplayMode::MODE_GAME ? STATE_MAX : STATE_GAME_MAX);
+    Communications::Write(Command::MODE_STATES);
+}
 
-    if (readButtonEvent == ButtonEvent::tap)
+//---------------------------------------------------------
+//---------------------------------------------------------
+bool ProcessEncoderButton(InputEventType buttonEvent)
+{
+    if (buttonEvent == InputEventType::INPUT_RELEASE)
     {
+        // Asleep the tap only wakes the display, leave it to INPUT_TAP.
+        if (g_DisplayAsleep || !(BUTTON_EARLY_TAP_MODES & _BV(g_SessionInfo.mode)))
+            return false;
+
+        // Only the mode state changes early, what reaches the host beyond it waits for INPUT_TAP.
+        g_EarlyTapMode = g_SessionInfo.mode;
+        g_EarlyTapState = g_ModeStates.states[g_SessionInfo.mode];
+        ToggleModeState();
+        Display::ResetTimers();
+        return true;
+    }
+    else if (buttonEvent == InputEventType::INPUT_TAP)
+    {
+        bool early = g_EarlyTapMode == g_SessionInfo.mode;
+        g_EarlyTapMode = DisplayMode::MODE_MAX;
+
         if (g_DisplayAsleep)
             return true;
 
-        g_ModeStates.states[g_SessionInfo.mode] = (g_ModeStates.states[g_SessionInfo.mode] + 1) % (g_SessionInfo.mode != DisplayMode::MODE_GAME ? STATE_MAX : STATE_GAME_MAX);
-        Communications::Write(Command::MODE_STATES);
+        if (!early)
+            ToggleModeState();
 
         if (g_SessionInfo.mode == DisplayMode::MODE_INPUT || g_SessionInfo.mode == DisplayMode::MODE_OUTPUT)
         {
@@ -372,8 +669,16 @@ bool ProcessEncoderButton()
         Display::ResetTimers();
         return true;
     }
-    else if (readButtonEvent == ButtonEvent::doubleTap)
+    else if (buttonEvent == InputEventType::INPUT_DOUBLE_TAP)
     {
+        // Roll back the early tap, the release was the first half of this double tap.
+        if (g_EarlyTapMode == g_SessionInfo.mode)
+        {
+            g_ModeStates.states[g_SessionInfo.mode] = g_EarlyTapState;
+            Communications::Write(Command::MODE_STATES);
+        }
+        g_EarlyTapMode = DisplayMode::MODE_MAX;
+
         if (g_SessionInfo.mode == DisplayMode::MODE_SPLASH)
             return false;
 
@@ -390,7 +695,7 @@ bool ProcessEncoderButton()
         }
         return true;
     }
-    else if (readButtonEvent == ButtonEvent::hold)
+    else if (buttonEvent == InputEventType::INPUT_HOLD)
     {
         if (g_DisplayAsleep)
             return true;
@@ -452,6 +757,41 @@ bool ProcessDisplayScroll()
     return false;
 }
 
+//---------------------------------------------------------
+// \brief Peak level of the current session while the host streams them, 0 otherwise.
+//---------------------------------------------------------
+uint8_t GetPeakMeterLevel()
+{
+    if (!IsPeakMeterScreen() || g_Now - g_PeakLevelsTime >= PEAK_METER_TIMEOUT)
+        return 0;
+    return g_PeakLevels.Get(SessionIndex::INDEX_CURRENT);
+}
+
+//---------------------------------------------------------
+// \brief The edit screens of output, input and application modes have a peak meter.
+//---------------------------------------------------------
+bool IsPeakMeterScreen()
+{
+    if (g_DisplayAsleep)
+        return false;
+    if (g_SessionInfo.mode != DisplayMode::MODE_OUTPUT && g_SessionInfo.mode != DisplayMode::MODE_INPUT && g_SessionInfo.mode != DisplayMode::MODE_APPLICATION)
+        return false;
+    return g_ModeStates.states[g_SessionInfo.mode] == STATE_EDIT;
+}
+
+//---------------------------------------------------------
+// \brief Sends just the meter strip when only the level changed, the rest of the screen stays as it is.
+//---------------------------------------------------------
+void UpdatePeakMeter()
+{
+    uint8_t level = GetPeakMeterLevel();
+    if (!IsPeakMeterScreen() || level == g_PeakMeterShown)
+        return;
+
+    g_PeakMeterShown = level;
+    Display::UpdatePeakMeter(level);
+}
+
 //---------------------------------------------------------
 //---------------------------------------------------------
 void UpdateDisplay()
@@ -0,0 +1,66 @@
+#pragma once
+//********************************************************
+// PROJECT: MAXMIX
+//
+// DECRIPTION:
+// Lock-free single producer / single consumer ring, for handing
+// data from an interrupt to loop() without cli()/sei().
+// The producer only writes head and the consumer only writes
+// tail, both are single bytes so their loads and stores are
+// atomic on AVR. Size must be a power of two, one slot is
+// always left free to tell full from empty.
+//********************************************************
+
+#include <stdint.h>
+
+template <typename T, uint8_t Size>
+class RingBuffer
+{
+    static_assert(Size >= 2 && (Size & (Size - 1)) == 0, "Size must be a power of two");
+
+public:
+    RingBuffer() : head(0), tail(0) {}
+
+    // Producer side. \returns false if the ring is full, the item is dropped.
+    bool Push(const T &item)
+    {
+        uint8_t next = (head + 1) & (Size - 1);
+        if (next == tail)
+            return false;
+        items[head] = item;
+        // Publish after the item is written, items is not volatile so keep the compiler from reordering.
+        __asm__ __volatile__("" ::: "memory");
+        head = next;
+        return true;
+    }
+
+    // Consumer side. \returns false if the ring is empty.
+    bool Pop(T &item)
+    {
+        uint8_t current = tail;
+        if (current == head)
+            return false;
+        __asm__ __volatile__("" ::: "memory");
+        item = items[current];
+        // Release the slot only once the item is copied out.
+        __asm__ __volatile__("" ::: "memory");
+        tail = (current + 1) & (Size - 1);
+        return true;
+    }
+
+    // Consumer side, drops everything pushed so far.
+    void Clear(void)
+    {
+        tail = head;
+    }
+
+    bool IsEmpty(void) const
+    {
+        return head == tail;
+    }
+
+private:
+    volatile uint8_t head;
+    volatile uint8_t tail;
+    T items[Size];
+};
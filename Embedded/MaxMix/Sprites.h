@@ -0,0 +1,74 @@
+#pragma once
+//********************************************************
+// PROJECT: MAXMIX
+//
+// DECRIPTION:
+// Generated by Native/tools/SpriteGenerator.cpp, don't edit.
+// Fixed screen elements for drawSprite(), 128x32 display
+// with DISPLAY_ROTATION 2.
+//********************************************************
+
+#include <Arduino.h>
+
+static const uint8_t SPRITE_DIGITS_X2[10][22] PROGMEM = {
+    {
+        10, 14,
+        0xFC, 0xFC, 0x03, 0x03, 0xC3, 0xC3, 0x33, 0x33, 0xFC, 0xFC,
+        0x0F, 0x0F, 0x33, 0x33, 0x30, 0x30, 0x30, 0x30, 0x0F, 0x0F,
+    },
+    {
+        10, 14,
+        0x00, 0x00, 0x03, 0x03, 0xFF, 0xFF, 0x03, 0x03, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x3F, 0x3F, 0x0C, 0x0C, 0x00, 0x00,
+    },
+    {
+        10, 14,
+        0x03, 0x03, 0xC3, 0xC3, 0xC3, 0xC3, 0xC3, 0xC3, 0x3F, 0x3F,
+        0x0F, 0x0F, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x0C, 0x0C,
+    },
+    {
+        10, 14,
+        0x3C, 0x3C, 0xC3, 0xC3, 0xC3, 0xC3, 0x03, 0x03, 0x0C, 0x0C,
+        0x3C, 0x3C, 0x33, 0x33, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30,
+    },
+    {
+        10, 14,
+        0x30, 0x30, 0xFF, 0xFF, 0x30, 0x30, 0x30, 0x30, 0xF0, 0xF0,
+        0x00, 0x00, 0x3F, 0x3F, 0x0C, 0x0C, 0x03, 0x03, 0x00, 0x00,
+    },
+    {
+        10, 14,
+        0xFC, 0xFC, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x0C, 0x0C,
+        0x30, 0x30, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x3F, 0x3F,
+    },
+    {
+        10, 14,
+        0x3C, 0x3C, 0xC3, 0xC3, 0xC3, 0xC3, 0xC3, 0xC3, 0xFC, 0xFC,
+        0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x0C, 0x0C, 0x03, 0x03,
+    },
+    {
+        10, 14,
+        0x00, 0x00, 0xC0, 0xC0, 0x30, 0x30, 0x0C, 0x0C, 0x03, 0x03,
+        0x3F, 0x3F, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30,
+    },
+    {
+        10, 14,
+        0x3C, 0x3C, 0xC3, 0xC3, 0xC3, 0xC3, 0xC3, 0xC3, 0x3C, 0x3C,
+        0x0F, 0x0F, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x0F, 0x0F,
+    },
+    {
+        10, 14,
+        0xF0, 0xF0, 0xCC, 0xCC, 0xC3, 0xC3, 0xC3, 0xC3, 0x03, 0x03,
+        0x0F, 0x0F, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x0F, 0x0F,
+    },
+};
+
+static const uint8_t SPRITE_ARROW_LEFT[] PROGMEM = {
+    4, 7,
+    0x7F, 0x3E, 0x1C, 0x08,
+};
+
+static const uint8_t SPRITE_ARROW_RIGHT[] PROGMEM = {
+    4, 7,
+    0x08, 0x1C, 0x3E, 0x7F,
+};
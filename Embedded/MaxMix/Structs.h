@@ -1,74 +1,41 @@
 #pragma once
 
 #include "Config.h"
+// Wire structs live in the shared protocol library so native host tools build against the exact same definitions.
+#include "src/Protocol/Messages.h"
 
-struct __attribute__((__packed__)) SessionInfo
+// Firmware only, never sent over the wire.
+struct InputEvent
 {
-    DisplayMode mode;    // 8 bits
-    uint8_t current;     // 8 bits
-    uint8_t sessions[3]; // 24 bits - output, input, application
-    // 40 bits - 5 bytes
-
-    SessionInfo() : mode(DisplayMode::MODE_SPLASH), current(0), sessions{0} {}
+    uint16_t time;       // millis() when the input happened, 16 bits is plenty for intervals
+    InputEventType type;
 };
-static_assert(sizeof(SessionInfo) == 5, "Invalid Expected Message Size");
 
-struct __attribute__((__packed__)) VolumeData
+// Palette color in 8.8 fixed point, the fraction is shown by temporal dithering.
+struct PaletteColor
 {
-    uint8_t id : 7;     // 7 bits
-    bool isDefault : 1; // 1 bit
-    uint8_t volume : 7; // 7 bits
-    bool isMuted : 1;   // 1 bit
-    // 16 bits - 2 bytes
-
-    VolumeData() : id(0), isDefault(false), volume(0), isMuted(false) {}
+    uint16_t r;
+    uint16_t g;
+    uint16_t b;
 };
-static_assert(sizeof(VolumeData) == 2, "Invalid Expected Message Size");
 
-struct __attribute__((__packed__)) SessionData
+// Firmware only, a point of an Effect's value curve. Values in between are interpolated.
+struct EffectKeyframe
 {
-    char name[30]; // 240 bits
-    VolumeData data; // 24 bits
-    // 256 bits - 32 bytes
-
-    // name & data use { } initializers
-    SessionData() : name{0}, data{} {}
+    uint8_t time;  // [0..255] over the effect period
+    uint8_t value; // [0..255]
 };
-static_assert(sizeof(SessionData) == 32, "Invalid Expected Message Size");
-
-struct __attribute__((__packed__)) Color
-{
-    uint8_t r; // 8 bits
-    uint8_t g; // 8 bits
-    uint8_t b; // 8 bits
-
-    Color() : r(0), g(0), b(0) {}
-    Color(uint8_t r, uint8_t g, uint8_t b) : r(r), g(g), b(b) {}
-}; // 24 bits - 3 bytes
-static_assert(sizeof(Color) == 3, "Invalid Expected Message Size");
 
-struct __attribute__((__packed__)) DeviceSettings
+// Firmware only, lighting effects are tables of these in PROGMEM, see LightingPlay().
+static const uint8_t EFFECT_KEYFRAMES_MAX = 4;
+struct Effect
 {
-    uint8_t sleepAfterSeconds;          // 8 Bits
-    uint8_t accelerationPercentage : 7; // 7 Bits
-    bool continuousScroll : 1;          // 1 Bit
-    Color volumeMinColor;               // 24 Bits
-    Color volumeMaxColor;               // 24 Bits
-    Color mixChannelAColor;             // 24 Bits
-    Color mixChannelBColor;             // 24 Bits
-    // 112 bits - 14 bytes
-
-    DeviceSettings() : sleepAfterSeconds(5), accelerationPercentage(60), continuousScroll(true),
-                 volumeMinColor(0, 0, 255), volumeMaxColor(255, 0, 0), mixChannelAColor(0, 0, 255), mixChannelBColor(255, 0, 255) {}
-};
-static_assert(sizeof(DeviceSettings) == 14, "Invalid Expected Message Size");
-
-struct __attribute__((__packed__)) ModeStates
-{
-    uint8_t states[DisplayMode::MODE_MAX]; // 40 bits
-    // 40 bits - 5 bytes
-
-    ModeStates() : states{0, 1, 1, 0, 0} {}
-    // states{STATE_LOGO, STATE_EDIT, STATE_EDIT, STATE_NAVIGATE, STATE_SELECT_A}
+    EffectType type;
+    EffectSource source;
+    uint16_t period;  // ms to go through the keyframes
+    bool loop;        // Starts over after period, otherwise holds the last keyframe
+    uint8_t spacing;  // EFFECT_TYPE_ROTATE lights one pixel every spacing
+    uint8_t hueRate;  // EFFECT_SOURCE_HUE hue steps per ms
+    uint8_t keyframesCount;
+    EffectKeyframe keyframes[EFFECT_KEYFRAMES_MAX];
 };
-static_assert(sizeof(ModeStates) == 5, "Invalid Expected Message Size");
\ No newline at end of file
@@ -49,6 +49,10 @@
   #include <time.h>
 #endif
 
+#if defined(MAXMIX_EMULATOR)
+#include "Native.h"
+#endif
+
 #if defined(NRF52) || defined(NRF52_SERIES)
 #include "nrf.h"
 
@@ -70,7 +74,26 @@
   @return  Adafruit_NeoPixel object. Call the begin() function before use.
 */
 Adafruit_NeoPixel::Adafruit_NeoPixel(uint16_t n, uint16_t p, neoPixelType t) :
-  begun(false), brightness(0), pixels(NULL), endTime(0) {
+  begun(false), brightness(0), pixels(NULL), capacity(0), endTime(0) {
+  updateType(t);
+  updateLength(n);
+  setPin(p);
+}
+
+/*!
+  @brief   NeoPixel constructor using a buffer provided by a subclass
+           instead of allocating one, see Adafruit_NeoPixelStatic.
+  @param   n         Number of NeoPixels in strand.
+  @param   p         Arduino pin number which will drive the NeoPixel data in.
+  @param   t         Pixel type, NEO_* constants as above.
+  @param   buffer    Pixel data, outlives the object and is never freed.
+  @param   capacity  Size of buffer in bytes.
+  @return  Adafruit_NeoPixel object. Call the begin() function before use.
+*/
+Adafruit_NeoPixel::Adafruit_NeoPixel(uint16_t n, uint16_t p, neoPixelType t,
+  uint8_t *buffer, uint16_t capacity) :
+  begun(false), numLEDs(0), brightness(0), pixels(buffer), capacity(capacity),
+  endTime(0) {
   updateType(t);
   updateLength(n);
   setPin(p);
@@ -91,14 +114,14 @@ Adafruit_NeoPixel::Adafruit_NeoPixel() :
   is800KHz(true),
 #endif
   begun(false), numLEDs(0), numBytes(0), pin(-1), brightness(0), pixels(NULL),
-  rOffset(1), gOffset(0), bOffset(2), wOffset(1), endTime(0) {
+  capacity(0), rOffset(1), gOffset(0), bOffset(2), wOffset(1), endTime(0) {
 }
 
 /*!
   @brief   Deallocate Adafruit_NeoPixel object, set data pin back to INPUT.
 */
 Adafruit_NeoPixel::~Adafruit_NeoPixel() {
-  free(pixels);
+  if(!capacity) free(pixels);
   if(pin >= 0) pinMode(pin, INPUT);
 }
 
@@ -124,10 +147,20 @@ void Adafruit_NeoPixel::begin(void) {
            type).
 */
 void Adafruit_NeoPixel::updateLength(uint16_t n) {
+  numBytes = n * ((wOffset == rOffset) ? 3 : 4);
+  if(capacity) { // External buffer, only cleared
+    if(numBytes <= capacity) {
+      memset(pixels, 0, numBytes);
+      numLEDs = n;
+    } else {
+      numLEDs = numBytes = 0;
+    }
+    return;
+  }
+
   free(pixels); // Free existing data (if any)
 
   // Allocate new data -- note: ALL PIXELS ARE CLEARED
-  numBytes = n * ((wOffset == rOffset) ? 3 : 4);
   if((pixels = (uint8_t *)malloc(numBytes))) {
     memset(pixels, 0, numBytes);
     numLEDs = n;
@@ -2196,6 +2229,14 @@ void Adafruit_NeoPixel::show(void) {
     }
   }
 
+#elif defined(MAXMIX_EMULATOR)
+// Native emulator build --------------------------------------------------
+// Hand the frame to the host and keep interrupts off for as long as the
+// 800 KHz transfer would (1.25 us per bit, 10 us per byte).
+
+  Native::ShowPixels(pixels, numBytes);
+  delayMicroseconds(numBytes * 10);
+
 #else
 #error Architecture not supported
 #endif
@@ -339,6 +339,11 @@ class Adafruit_NeoPixel {
 
  protected:
 
+  // Constructor for subclasses that own the pixel buffer, see
+  // Adafruit_NeoPixelStatic. The buffer must hold at least capacity bytes.
+  Adafruit_NeoPixel(uint16_t n, uint16_t pin, neoPixelType type,
+    uint8_t *buffer, uint16_t capacity);
+
 #ifdef NEO_KHZ400  // If 400 KHz NeoPixel support enabled...
   bool              is800KHz;   ///< true if 800 KHz pixels
 #endif
@@ -348,6 +353,7 @@ class Adafruit_NeoPixel {
   int16_t           pin;        ///< Output pin number (-1 if not yet set)
   uint8_t           brightness; ///< Strip brightness 0-255 (stored as +1)
   uint8_t          *pixels;     ///< Holds LED color values (3 or 4 bytes each)
+  uint16_t          capacity;   ///< Size of an external 'pixels' buffer, 0 if malloc'd
   uint8_t           rOffset;    ///< Red index within each 3- or 4-byte pixel
   uint8_t           gOffset;    ///< Index of green byte
   uint8_t           bOffset;    ///< Index of blue byte
@@ -363,4 +369,27 @@ class Adafruit_NeoPixel {
 #endif
 };
 
+/*!
+    @brief  NeoPixel strip with its pixel buffer stored inline, sized at
+            compile time. Nothing is taken from the heap, the buffer shows
+            up with the object in the linker's RAM usage.
+    @tparam N     Number of NeoPixels in strand.
+    @tparam TYPE  Pixel type, NEO_* constants as for Adafruit_NeoPixel.
+    @note   updateLength() and updateType() can't grow the strip past the
+            buffer, a strip that doesn't fit is left empty.
+*/
+template <uint16_t N, neoPixelType TYPE = NEO_GRB + NEO_KHZ800>
+class Adafruit_NeoPixelStatic : public Adafruit_NeoPixel {
+
+ public:
+
+  Adafruit_NeoPixelStatic(uint16_t pin=6) :
+    Adafruit_NeoPixel(N, pin, TYPE, storage, sizeof(storage)) {}
+
+ private:
+
+  // 3 bytes per pixel if the white offset matches red, like updateLength().
+  uint8_t           storage[N * ((((TYPE >> 6) & 0b11) == ((TYPE >> 4) & 0b11)) ? 3 : 4)];
+};
+
 #endif // ADAFRUIT_NEOPIXEL_H
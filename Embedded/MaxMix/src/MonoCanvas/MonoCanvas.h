@@ -0,0 +1,515 @@
+#pragma once
+//********************************************************
+// PROJECT: MAXMIX
+//
+// DECRIPTION:
+// 1 bit per pixel frame buffer with its size, rotation and
+// page count fixed at compile time. It has the Adafruit_GFX
+// calls Display.cpp uses and draws the same pixels with them,
+// but none of them are virtual: they inline down to buffer
+// writes, rotation and clipping bounds become constants.
+// Only text goes through Print, one virtual call per char.
+// Fixed elements can be drawn from pre-rasterized sprites
+// instead, see drawSprite().
+//
+// The buffer is a member holding PAGES pages of 8 rows. With
+// fewer pages than the display the screen is drawn once per
+// page between firstPage() and nextPage(), once with all of
+// them. The display specific class derives from
+// MonoCanvas<Derived, ...> and implements:
+//
+//   void SendWindow(uint8_t x, uint8_t w, uint8_t page0, uint8_t page1);
+//   void SendData(const uint8_t *data, uint8_t w, uint8_t pages);
+//
+// The window is columns x to x + w - 1 of page0 to page1, the
+// data sent after it fills it a page at a time. data is w
+// bytes of a page, each next page WIDTH bytes on.
+//********************************************************
+
+#include <Arduino.h>
+#include <Print.h>
+#include "../Adafruit_GFX/glcdfont.c"
+
+// Same values as Adafruit_SSD1306, screens draw with either.
+#ifndef BLACK
+#define BLACK 0
+#define WHITE 1
+#define INVERSE 2
+#endif
+
+template <class Derived, uint8_t WIDTH, uint8_t HEIGHT, uint8_t ROTATION, uint8_t PAGES = HEIGHT / 8>
+class MonoCanvas : public Print
+{
+    static_assert(HEIGHT % 8 == 0 && (HEIGHT / 8) % PAGES == 0, "The display height must be a multiple of the pages held");
+    static_assert(ROTATION < 4, "Rotation is 0 to 3, quarter turns");
+
+public:
+    static const uint8_t DISPLAY_PAGES = HEIGHT / 8;
+
+    MonoCanvas() : page(0), regionX(0), regionW(WIDTH), cursorX(0), cursorY(0), textColor(WHITE), textBgColor(WHITE), textSize(1), wrap(true) {}
+
+    using Print::write;
+
+    //---------------------------------------------------------
+    // Size & buffer
+    //---------------------------------------------------------
+    // Size once rotated, what drawing coordinates are relative to.
+    static int16_t width() { return ROTATION & 1 ? HEIGHT : WIDTH; }
+    static int16_t height() { return ROTATION & 1 ? WIDTH : HEIGHT; }
+    static uint8_t getRotation() { return ROTATION; }
+
+    // Rectangle in drawing coordinates to buffer coordinates, the switch folds away.
+    static void Rotate(int16_t &x, int16_t &y, int16_t &w, int16_t &h)
+    {
+        switch (ROTATION)
+        {
+        case 1:
+            Swap(x, y);
+            Swap(w, h);
+            x = WIDTH - x - w;
+            break;
+        case 2:
+            x = WIDTH - x - w;
+            y = HEIGHT - y - h;
+            break;
+        case 3:
+            Swap(x, y);
+            Swap(w, h);
+            y = HEIGHT - y - h;
+            break;
+        }
+    }
+
+    uint8_t *getBuffer() { return buffer; }
+
+    void clearDisplay() { memset(buffer, 0, sizeof(buffer)); }
+
+    //---------------------------------------------------------
+    // Pages
+    //---------------------------------------------------------
+    // Starts a frame at the first page. Only columns x to x + w - 1 are sent, 0 for the whole width.
+    // Their window spans every page, the pages drawn then only send their data into it.
+    void firstPage(uint8_t x = 0, uint8_t w = 0)
+    {
+        page = 0;
+        regionX = x;
+        regionW = w ? w : WIDTH;
+        static_cast<Derived *>(this)->SendWindow(regionX, regionW, 0, DISPLAY_PAGES - 1);
+    }
+
+    // Sends the pages just drawn.
+    // \returns true while there are pages left to draw
+    bool nextPage()
+    {
+        static_cast<Derived *>(this)->SendData(&buffer[regionX], regionW, PAGES);
+        page += PAGES;
+        if (page < DISPLAY_PAGES)
+            return true;
+        page = 0;
+        return false;
+    }
+
+    // Sends the pages held, the whole frame with a full buffer.
+    void display()
+    {
+        static_cast<Derived *>(this)->SendWindow(0, WIDTH, page, page + PAGES - 1);
+        static_cast<Derived *>(this)->SendData(buffer, WIDTH, PAGES);
+    }
+
+    //---------------------------------------------------------
+    // Primitives
+    //---------------------------------------------------------
+    void drawPixel(int16_t x, int16_t y, uint16_t color)
+    {
+        if (x < 0 || x >= width() || y < 0 || y >= height())
+            return;
+
+        int16_t w = 1, h = 1;
+        Rotate(x, y, w, h);
+        y -= page * 8;
+        if (y < 0 || y >= PAGES * 8)
+            return;
+
+        uint8_t *p = &buffer[(y / 8) * WIDTH + x];
+        uint8_t bit = 1 << (y & 7);
+        switch (color)
+        {
+        case WHITE:
+            *p |= bit;
+            break;
+        case BLACK:
+            *p &= ~bit;
+            break;
+        case INVERSE:
+            *p ^= bit;
+            break;
+        }
+    }
+
+    void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color)
+    {
+        if (w <= 0 || h <= 0)
+            return;
+
+        Rotate(x, y, w, h);
+
+        // Clip to the display width and to the rows held by the buffer.
+        if (x < 0)
+        {
+            w += x;
+            x = 0;
+        }
+        if (x + w > WIDTH)
+            w = WIDTH - x;
+        y -= page * 8;
+        if (y < 0)
+        {
+            h += y;
+            y = 0;
+        }
+        if (y + h > PAGES * 8)
+            h = PAGES * 8 - y;
+        if (w <= 0 || h <= 0)
+            return;
+
+        // A byte is a column of 8 rows, full pages are set whole and the ends masked.
+        uint8_t page0 = y / 8;
+        uint8_t page1 = (y + h - 1) / 8;
+        uint8_t mask0 = 0xFF << (y & 7);
+        uint8_t mask1 = 0xFF >> (7 - ((y + h - 1) & 7));
+        uint8_t *row = &buffer[page0 * WIDTH + x];
+        for (uint8_t p = page0; p <= page1; p++, row += WIDTH)
+        {
+            uint8_t mask = 0xFF;
+            if (p == page0)
+                mask &= mask0;
+            if (p == page1)
+                mask &= mask1;
+
+            uint8_t *b = row;
+            uint8_t n = w;
+            switch (color)
+            {
+            case WHITE:
+                if (mask == 0xFF)
+                    memset(b, 0xFF, n);
+                else
+                    while (n--)
+                        *b++ |= mask;
+                break;
+            case BLACK:
+                if (mask == 0xFF)
+                    memset(b, 0x00, n);
+                else
+                {
+                    mask = ~mask;
+                    while (n--)
+                        *b++ &= mask;
+                }
+                break;
+            case INVERSE:
+                while (n--)
+                    *b++ ^= mask;
+                break;
+            }
+        }
+    }
+
+    void drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) { fillRect(x, y, w, 1, color); }
+    void drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) { fillRect(x, y, 1, h, color); }
+
+    void drawRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color)
+    {
+        drawFastHLine(x, y, w, color);
+        drawFastHLine(x, y + h - 1, w, color);
+        drawFastVLine(x, y, h, color);
+        drawFastVLine(x + w - 1, y, h, color);
+    }
+
+    // Bresenham as in Adafruit_GFX, straight lines are rectangles.
+    void drawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color)
+    {
+        if (x0 == x1)
+        {
+            if (y0 > y1)
+                Swap(y0, y1);
+            drawFastVLine(x0, y0, y1 - y0 + 1, color);
+            return;
+        }
+        if (y0 == y1)
+        {
+            if (x0 > x1)
+                Swap(x0, x1);
+            drawFastHLine(x0, y0, x1 - x0 + 1, color);
+            return;
+        }
+
+        bool steep = abs(y1 - y0) > abs(x1 - x0);
+        if (steep)
+        {
+            Swap(x0, y0);
+            Swap(x1, y1);
+        }
+        if (x0 > x1)
+        {
+            Swap(x0, x1);
+            Swap(y0, y1);
+        }
+
+        int16_t dx = x1 - x0;
+        int16_t dy = abs(y1 - y0);
+        int16_t err = dx / 2;
+        int16_t ystep = y0 < y1 ? 1 : -1;
+        for (; x0 <= x1; x0++)
+        {
+            if (steep)
+                drawPixel(y0, x0, color);
+            else
+                drawPixel(x0, y0, color);
+            err -= dy;
+            if (err < 0)
+            {
+                y0 += ystep;
+                err += dx;
+            }
+        }
+    }
+
+    // Scanlines as in Adafruit_GFX, so edges land on the same pixels.
+    void fillTriangle(int16_t x0, int16_t y0, int16_t x1, int16_t y1, int16_t x2, int16_t y2, uint16_t color)
+    {
+        // Sort by y, y0 <= y1 <= y2
+        if (y0 > y1)
+        {
+            Swap(y0, y1);
+            Swap(x0, x1);
+        }
+        if (y1 > y2)
+        {
+            Swap(y2, y1);
+            Swap(x2, x1);
+        }
+        if (y0 > y1)
+        {
+            Swap(y0, y1);
+            Swap(x0, x1);
+        }
+
+        int16_t a, b, y, last;
+        if (y0 == y2)
+        {
+            a = b = x0;
+            if (x1 < a)
+                a = x1;
+            else if (x1 > b)
+                b = x1;
+            if (x2 < a)
+                a = x2;
+            else if (x2 > b)
+                b = x2;
+            drawFastHLine(a, y0, b - a + 1, color);
+            return;
+        }
+
+        int16_t dx01 = x1 - x0, dy01 = y1 - y0, dx02 = x2 - x0, dy02 = y2 - y0, dx12 = x2 - x1, dy12 = y2 - y1;
+        int32_t sa = 0, sb = 0;
+
+        // Upper part, includes the y1 scanline only for flat bottoms, the lower part does it otherwise.
+        last = y1 == y2 ? y1 : y1 - 1;
+        for (y = y0; y <= last; y++)
+        {
+            a = x0 + sa / dy01;
+            b = x0 + sb / dy02;
+            sa += dx01;
+            sb += dx02;
+            if (a > b)
+                Swap(a, b);
+            drawFastHLine(a, y, b - a + 1, color);
+        }
+
+        sa = (int32_t)dx12 * (y - y1);
+        sb = (int32_t)dx02 * (y - y0);
+        for (; y <= y2; y++)
+        {
+            a = x1 + sa / dy12;
+            b = x0 + sb / dy02;
+            sa += dx12;
+            sb += dx02;
+            if (a > b)
+                Swap(a, b);
+            drawFastHLine(a, y, b - a + 1, color);
+        }
+    }
+
+    // PROGMEM bitmap, rows of whole bytes with the left pixel in the MSB. Clear bits are transparent.
+    void drawBitmap(int16_t x, int16_t y, const uint8_t bitmap[], int16_t w, int16_t h, uint16_t color)
+    {
+        int16_t byteWidth = (w + 7) / 8;
+        uint8_t bits = 0;
+        for (int16_t j = 0; j < h; j++, y++)
+        {
+            for (int16_t i = 0; i < w; i++)
+            {
+                if (i & 7)
+                    bits <<= 1;
+                else
+                    bits = pgm_read_byte(&bitmap[j * byteWidth + i / 8]);
+                if (bits & 0x80)
+                    drawPixel(x + i, y, color);
+            }
+        }
+    }
+
+    // PROGMEM sprite, its width and height then its pixels as they are in the buffer, already
+    // rotated by ROTATION: columns of 8 rows per byte, top row in bit 0, a page of columns
+    // after the other. Set bits are drawn in color, clear ones are transparent.
+    void drawSprite(int16_t x, int16_t y, const uint8_t *sprite, uint16_t color = WHITE)
+    {
+        int16_t w = pgm_read_byte(&sprite[0]);
+        int16_t h = pgm_read_byte(&sprite[1]);
+        const uint8_t *data = &sprite[2];
+        Rotate(x, y, w, h);
+
+        // Columns on the display
+        int16_t i0 = x < 0 ? -x : 0;
+        int16_t i1 = x + w > WIDTH ? WIDTH - x : w;
+        if (i0 >= i1)
+            return;
+
+        // Each sprite page is shifted down into two buffer pages, only the ones held are drawn.
+        y -= page * 8;
+        int16_t top = y >> 3;
+        uint8_t shift = y & 7;
+        uint8_t pages = (h + 7) / 8;
+        for (uint8_t p = 0; p < pages; p++, top++, data += w)
+        {
+            if (top >= PAGES)
+                break;
+            bool upper = top >= 0;
+            bool lower = shift && top + 1 >= 0 && top + 1 < PAGES;
+            if (!upper && !lower)
+                continue;
+
+            int16_t column = top * WIDTH + x;
+            for (int16_t i = i0; i < i1; i++)
+            {
+                uint8_t bits = pgm_read_byte(&data[i]);
+                if (upper)
+                    Blend(buffer[column + i], bits << shift, color);
+                if (lower)
+                    Blend(buffer[column + WIDTH + i], bits >> (8 - shift), color);
+            }
+        }
+    }
+
+    //---------------------------------------------------------
+    // Text, the classic 5x7 Adafruit_GFX font only
+    //---------------------------------------------------------
+    void setCursor(int16_t x, int16_t y)
+    {
+        cursorX = x;
+        cursorY = y;
+    }
+
+    int16_t getCursorX() const { return cursorX; }
+    int16_t getCursorY() const { return cursorY; }
+
+    void setTextSize(uint8_t size) { textSize = size > 0 ? size : 1; }
+    // Same background and text color, the background is not drawn.
+    void setTextColor(uint16_t color) { textColor = textBgColor = color; }
+    void setTextColor(uint16_t color, uint16_t background)
+    {
+        textColor = color;
+        textBgColor = background;
+    }
+    void setTextWrap(bool enabled) { wrap = enabled; }
+
+    void drawChar(int16_t x, int16_t y, unsigned char c, uint16_t color, uint16_t background, uint8_t size)
+    {
+        if (x >= width() || y >= height() || x + 6 * size - 1 < 0 || y + 8 * size - 1 < 0)
+            return;
+
+        // Adafruit_GFX skips a glyph from 176 on unless cp437() is set, keep its mapping.
+        if (c >= 176)
+            c++;
+
+        for (int8_t i = 0; i < 5; i++)
+        {
+            uint8_t line = pgm_read_byte(&font[c * 5 + i]);
+            for (int8_t j = 0; j < 8; j++, line >>= 1)
+            {
+                if (line & 1)
+                    DrawDot(x + i * size, y + j * size, size, color);
+                else if (background != color)
+                    DrawDot(x + i * size, y + j * size, size, background);
+            }
+        }
+        if (background != color)
+            fillRect(x + 5 * size, y, size, 8 * size, background);
+    }
+
+    size_t write(uint8_t c) override
+    {
+        if (c == '\n')
+        {
+            cursorX = 0;
+            cursorY += textSize * 8;
+        }
+        else if (c != '\r')
+        {
+            if (wrap && cursorX + textSize * 6 > width())
+            {
+                cursorX = 0;
+                cursorY += textSize * 8;
+            }
+            drawChar(cursorX, cursorY, c, textColor, textBgColor, textSize);
+            cursorX += textSize * 6;
+        }
+        return 1;
+    }
+
+protected:
+    uint8_t buffer[WIDTH * PAGES];
+
+private:
+    static void Swap(int16_t &a, int16_t &b)
+    {
+        int16_t t = a;
+        a = b;
+        b = t;
+    }
+
+    static void Blend(uint8_t &b, uint8_t bits, uint16_t color)
+    {
+        switch (color)
+        {
+        case WHITE:
+            b |= bits;
+            break;
+        case BLACK:
+            b &= ~bits;
+            break;
+        case INVERSE:
+            b ^= bits;
+            break;
+        }
+    }
+
+    void DrawDot(int16_t x, int16_t y, uint8_t size, uint16_t color)
+    {
+        if (size == 1)
+            drawPixel(x, y, color);
+        else
+            fillRect(x, y, size, size, color);
+    }
+
+    uint8_t page;
+    uint8_t regionX;
+    uint8_t regionW;
+    int16_t cursorX;
+    int16_t cursorY;
+    uint8_t textColor;
+    uint8_t textBgColor;
+    uint8_t textSize;
+    bool wrap;
+};
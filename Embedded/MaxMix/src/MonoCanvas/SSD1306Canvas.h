@@ -0,0 +1,115 @@
+#pragma once
+//********************************************************
+// PROJECT: MAXMIX
+//
+// DECRIPTION:
+// MonoCanvas for an SSD1306 on I2C. Sends the init sequence,
+// address window and data of Adafruit_SSD1306, so the panel
+// ends up the same. It doesn't change the Wire clock, set it
+// after begin().
+//********************************************************
+
+#include <Wire.h>
+#include "../Adafruit_SSD1306/Adafruit_SSD1306.h"
+#include "MonoCanvas.h"
+
+template <uint8_t WIDTH, uint8_t HEIGHT, uint8_t ROTATION, uint8_t PAGES = HEIGHT / 8>
+class SSD1306Canvas : public MonoCanvas<SSD1306Canvas<WIDTH, HEIGHT, ROTATION, PAGES>, WIDTH, HEIGHT, ROTATION, PAGES>
+{
+    friend class MonoCanvas<SSD1306Canvas, WIDTH, HEIGHT, ROTATION, PAGES>;
+
+public:
+    // resetPin -1 when the panel shares the Arduino reset.
+    SSD1306Canvas(int8_t resetPin = -1) : address(0), resetPin(resetPin) {}
+
+    // Same arguments as Adafruit_SSD1306::begin(), addr 0 picks the usual address for the height.
+    bool begin(uint8_t vcc = SSD1306_SWITCHCAPVCC, uint8_t addr = 0, bool reset = true, bool periphBegin = true)
+    {
+        this->clearDisplay();
+        address = addr ? addr : (HEIGHT == 32 ? 0x3C : 0x3D);
+        if (periphBegin)
+            Wire.begin();
+
+        if (reset && resetPin >= 0)
+        {
+            pinMode(resetPin, OUTPUT);
+            digitalWrite(resetPin, HIGH);
+            delay(1);
+            digitalWrite(resetPin, LOW);
+            delay(10);
+            digitalWrite(resetPin, HIGH);
+        }
+
+        bool external = vcc == SSD1306_EXTERNALVCC;
+        uint8_t contrast = HEIGHT == 32 ? 0x8F : HEIGHT == 64 ? (external ? 0x9F : 0xCF) : (external ? 0x10 : 0xAF);
+        const uint8_t init[] = {
+            SSD1306_DISPLAYOFF,
+            SSD1306_SETDISPLAYCLOCKDIV, 0x80,
+            SSD1306_SETMULTIPLEX, HEIGHT - 1,
+            SSD1306_SETDISPLAYOFFSET, 0x00,
+            SSD1306_SETSTARTLINE | 0x00,
+            SSD1306_CHARGEPUMP, (uint8_t)(external ? 0x10 : 0x14),
+            SSD1306_MEMORYMODE, 0x00,
+            SSD1306_SEGREMAP | 0x01,
+            SSD1306_COMSCANDEC,
+            SSD1306_SETCOMPINS, HEIGHT == 64 ? 0x12 : 0x02,
+            SSD1306_SETCONTRAST, contrast,
+            SSD1306_SETPRECHARGE, (uint8_t)(external ? 0x22 : 0xF1),
+            SSD1306_SETVCOMDETECT, 0x40,
+            SSD1306_DISPLAYALLON_RESUME,
+            SSD1306_NORMALDISPLAY,
+            SSD1306_DEACTIVATE_SCROLL,
+            SSD1306_DISPLAYON};
+        Send(CONTROL_COMMAND, init, sizeof(init), 1);
+        return true;
+    }
+
+private:
+    static const uint8_t CONTROL_COMMAND = 0x00; // Co = 0, D/C = 0
+    static const uint8_t CONTROL_DATA = 0x40;    // Co = 0, D/C = 1
+#if defined(BUFFER_LENGTH)
+    static const uint8_t WIRE_MAX = BUFFER_LENGTH;
+#else
+    static const uint8_t WIRE_MAX = 32;
+#endif
+
+    // The panel keeps its address across transfers, data goes on filling the window where
+    // the last transfer left it, as with the Wire buffer sized ones of Adafruit_SSD1306::display().
+    void SendWindow(uint8_t x, uint8_t w, uint8_t page0, uint8_t page1)
+    {
+        const uint8_t window[] = {SSD1306_PAGEADDR, page0, page1, SSD1306_COLUMNADDR, x, (uint8_t)(x + w - 1)};
+        Send(CONTROL_COMMAND, window, sizeof(window), 1);
+    }
+
+    void SendData(const uint8_t *data, uint8_t w, uint8_t pages)
+    {
+        Send(CONTROL_DATA, data, w, pages);
+    }
+
+    // Sends rows of length bytes, WIDTH bytes apart, after the control byte.
+    void Send(uint8_t control, const uint8_t *data, uint8_t length, uint8_t rows)
+    {
+        Wire.beginTransmission(address);
+        Wire.write(control);
+        uint8_t bytesOut = 1;
+        for (; rows > 0; rows--, data += WIDTH)
+        {
+            for (uint8_t i = 0; i < length; i++)
+            {
+                if (bytesOut >= WIRE_MAX)
+                {
+                    Wire.endTransmission();
+                    Wire.beginTransmission(address);
+                    Wire.write(control);
+                    bytesOut = 1;
+                }
+                Wire.write(data[i]);
+                bytesOut++;
+            }
+        }
+        Wire.endTransmission();
+    }
+
+    uint8_t address;
+    int8_t resetPin;
+};
@@ -0,0 +1,216 @@
+#pragma once
+//********************************************************
+// PROJECT: MAXMIX
+//
+// DECRIPTION:
+// Framing, encoder and decoder for the MaxMix serial protocol.
+// Header-only, no heap and no Arduino dependencies so the same
+// code runs on the AVR firmware and in native host tools.
+//
+// Frame layout: [Command (1 byte)][payload (PayloadSize bytes)]
+// The only variable length frame is the TEST reply sent to the host,
+// its payload is the firmware version terminated by a new line.
+//********************************************************
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include "Messages.h"
+
+namespace Protocol
+{
+    //********************************************************
+    // *** CONSTS
+    //********************************************************
+    enum Direction : uint8_t
+    {
+        TO_DEVICE, // Host -> Device
+        TO_HOST    // Device -> Host
+    };
+
+    // Returned by PayloadSize for frames terminated by a new line instead of a fixed size.
+    static const uint8_t PAYLOAD_LINE = 0xFF;
+    // Largest payload of any frame, also used as the maximum version line length.
+    static const uint8_t PAYLOAD_MAX = sizeof(SessionData);
+    static const uint8_t FRAME_MAX = PAYLOAD_MAX + 1;
+
+    //********************************************************
+    // *** FUNCTIONS
+    //********************************************************
+    inline bool IsCommand(int8_t command)
+    {
+        return command >= Command::ERROR && command <= Command::PEAK_LEVELS;
+    }
+
+    // Number of payload bytes that follow the command byte, per direction.
+    inline uint8_t PayloadSize(Command command, Direction direction)
+    {
+        switch (command)
+        {
+        case Command::TEST:
+            return direction == Direction::TO_HOST ? PAYLOAD_LINE : 0;
+        case Command::SETTINGS:
+            return sizeof(DeviceSettings);
+        case Command::SESSION_INFO:
+            return sizeof(SessionInfo);
+        case Command::CURRENT_SESSION:
+        case Command::ALTERNATE_SESSION:
+        case Command::PREVIOUS_SESSION:
+        case Command::NEXT_SESSION:
+            return sizeof(SessionData);
+        case Command::VOLUME_CURR_CHANGE:
+        case Command::VOLUME_ALT_CHANGE:
+        case Command::VOLUME_PREV_CHANGE:
+        case Command::VOLUME_NEXT_CHANGE:
+            return sizeof(VolumeData);
+        case Command::MODE_STATES:
+            return sizeof(ModeStates);
+        case Command::PROBE:
+            // The host only sends its timestamp, the device replies with the full ProbeData.
+            return direction == Direction::TO_HOST ? sizeof(ProbeData) : sizeof(ProbeData::hostTime);
+        case Command::STATS:
+            return direction == Direction::TO_HOST ? sizeof(LinkStats) : 0;
+        case Command::DIAGNOSTICS:
+            return direction == Direction::TO_HOST ? sizeof(Diagnostics) : 0;
+        case Command::PEAK_LEVELS:
+            return direction == Direction::TO_DEVICE ? sizeof(PeakLevels) : 0;
+        default:
+            // ERROR, NONE, OK, DEBUG
+            return 0;
+        }
+    }
+
+    // Writes a full frame into out, which must hold at least length + 1 bytes.
+    // \returns number of bytes written
+    inline size_t Encode(Command command, const void *payload, uint8_t length, uint8_t *out)
+    {
+        out[0] = (uint8_t)command;
+        if (length > 0)
+            memcpy(out + 1, payload, length);
+        return length + 1;
+    }
+
+    template <typename T>
+    inline size_t Encode(Command command, const T &message, uint8_t *out)
+    {
+        return Encode(command, &message, sizeof(T), out);
+    }
+
+    inline size_t Encode(Command command, uint8_t *out)
+    {
+        return Encode(command, NULL, 0, out);
+    }
+
+    // Reinterprets a payload in place. Structs are packed so there are no alignment requirements.
+    template <typename T>
+    inline const T *View(const uint8_t *payload)
+    {
+        return reinterpret_cast<const T *>(payload);
+    }
+
+    //********************************************************
+    // *** CLASSES
+    //********************************************************
+    // Incremental frame decoder, push bytes as they arrive and read the frame when Push returns true.
+    // The payload stays valid until the next call to Push.
+    class Decoder
+    {
+    public:
+        Decoder(Direction direction) : direction(direction), command(Command::NONE), expected(0), length(0), errors(0), receiving(false) {}
+
+        // \returns true when a complete frame is available
+        bool Push(uint8_t data)
+        {
+            if (!receiving)
+            {
+                if (!IsCommand((int8_t)data))
+                {
+                    errors++;
+                    return false;
+                }
+
+                command = (Command)data;
+                expected = PayloadSize(command, direction);
+                length = 0;
+                receiving = expected != 0;
+                return !receiving;
+            }
+
+            if (expected == PAYLOAD_LINE)
+            {
+                if (data == '\r')
+                    return false;
+                if (data == '\n')
+                {
+                    payload[length] = 0;
+                    receiving = false;
+                    return true;
+                }
+                // Leave room for the terminator, an over-long line is dropped.
+                if (length >= PAYLOAD_MAX - 1)
+                {
+                    errors++;
+                    receiving = false;
+                    return false;
+                }
+                payload[length++] = data;
+                return false;
+            }
+
+            payload[length++] = data;
+            if (length < expected)
+                return false;
+
+            receiving = false;
+            return true;
+        }
+
+        // \returns number of bytes consumed, frame is only valid if ready is set
+        size_t Push(const uint8_t *data, size_t count, bool &ready)
+        {
+            ready = false;
+            for (size_t i = 0; i < count; i++)
+            {
+                if (Push(data[i]))
+                {
+                    ready = true;
+                    return i + 1;
+                }
+            }
+            return count;
+        }
+
+        void Reset()
+        {
+            command = Command::NONE;
+            length = 0;
+            expected = 0;
+            receiving = false;
+        }
+
+        Command GetCommand() const { return command; }
+        const uint8_t *GetPayload() const { return payload; }
+        uint8_t GetLength() const { return length; }
+        uint16_t GetErrors() const { return errors; }
+        // True while a frame has started but its payload is incomplete.
+        bool IsReceiving() const { return receiving; }
+
+        template <typename T>
+        const T *View() const
+        {
+            return length == sizeof(T) ? Protocol::View<T>(payload) : NULL;
+        }
+
+        // TEST reply payload, null terminated.
+        const char *GetLine() const { return (const char *)payload; }
+
+    private:
+        Direction direction;
+        Command command;
+        uint8_t expected;
+        uint8_t length;
+        uint16_t errors;
+        bool receiving;
+        uint8_t payload[PAYLOAD_MAX];
+    };
+} // namespace Protocol
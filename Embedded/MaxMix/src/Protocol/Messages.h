@@ -0,0 +1,205 @@
+#pragma once
+//********************************************************
+// PROJECT: MAXMIX
+//
+// DECRIPTION:
+// Wire format shared by the firmware and the native host tools.
+// Every message is a Command byte followed by one of the packed
+// structs below, sent as-is (little endian, LSB-first bitfields).
+// Keep Desktop/Application/MaxMix/Services/Communication/Messages.cs in sync.
+//********************************************************
+
+#include <stddef.h>
+#include <stdint.h>
+
+//********************************************************
+// *** ENUMS
+//********************************************************
+enum Command : int8_t
+{
+    ERROR = -1,
+    NONE = 0,
+    TEST = 1,
+    OK,
+    SETTINGS,
+    SESSION_INFO,
+    CURRENT_SESSION,
+    ALTERNATE_SESSION,
+    PREVIOUS_SESSION,
+    NEXT_SESSION,
+    VOLUME_CURR_CHANGE,
+    VOLUME_ALT_CHANGE,
+    VOLUME_PREV_CHANGE,
+    VOLUME_NEXT_CHANGE,
+    MODE_STATES,
+    DEBUG,
+    PROBE,
+    STATS,
+    DIAGNOSTICS,
+    PEAK_LEVELS
+};
+
+enum SessionIndex : uint8_t
+{
+    INDEX_CURRENT,
+    INDEX_ALTERNATE,
+    INDEX_PREVIOUS,
+    INDEX_NEXT,
+    INDEX_MAX
+};
+
+enum DisplayMode : uint8_t
+{
+    MODE_SPLASH,
+    MODE_OUTPUT,
+    MODE_INPUT,
+    MODE_APPLICATION,
+    MODE_GAME,
+    MODE_MAX
+};
+
+// Lighting effects the host can pick for each DeviceSettings effect slot.
+enum LightingEffect : uint8_t
+{
+    EFFECT_OFF,      // All pixels off
+    EFFECT_PULSE,    // Fast pulse between the two colors
+    EFFECT_BREATHE,  // Slow fade in and out of the gradient between the two colors
+    EFFECT_SPIN,     // Every other pixel stepping around, cycling through the hues
+    EFFECT_RAINBOW,  // Hue wheel rotating around the ring
+    EFFECT_FADE_OUT, // Volume ring fading to black once
+    EFFECT_MAX
+};
+
+//********************************************************
+// *** STRUCTS
+//********************************************************
+struct __attribute__((__packed__)) SessionInfo
+{
+    DisplayMode mode;    // 8 bits
+    uint8_t current;     // 8 bits
+    uint8_t sessions[3]; // 24 bits - output, input, application
+    // 40 bits - 5 bytes
+
+    SessionInfo() : mode(DisplayMode::MODE_SPLASH), current(0), sessions{0} {}
+};
+static_assert(sizeof(SessionInfo) == 5, "Invalid Expected Message Size");
+
+struct __attribute__((__packed__)) VolumeData
+{
+    uint8_t id : 7;     // 7 bits
+    bool isDefault : 1; // 1 bit
+    uint8_t volume : 7; // 7 bits
+    bool isMuted : 1;   // 1 bit
+    // 16 bits - 2 bytes
+
+    VolumeData() : id(0), isDefault(false), volume(0), isMuted(false) {}
+};
+static_assert(sizeof(VolumeData) == 2, "Invalid Expected Message Size");
+
+struct __attribute__((__packed__)) SessionData
+{
+    char name[30]; // 240 bits
+    VolumeData data; // 24 bits
+    // 256 bits - 32 bytes
+
+    // name & data use { } initializers
+    SessionData() : name{0}, data{} {}
+};
+static_assert(sizeof(SessionData) == 32, "Invalid Expected Message Size");
+
+struct __attribute__((__packed__)) Color
+{
+    uint8_t r; // 8 bits
+    uint8_t g; // 8 bits
+    uint8_t b; // 8 bits
+
+    Color() : r(0), g(0), b(0) {}
+    Color(uint8_t r, uint8_t g, uint8_t b) : r(r), g(g), b(b) {}
+}; // 24 bits - 3 bytes
+static_assert(sizeof(Color) == 3, "Invalid Expected Message Size");
+
+struct __attribute__((__packed__)) DeviceSettings
+{
+    uint8_t sleepAfterSeconds;          // 8 Bits
+    uint8_t accelerationPercentage : 7; // 7 Bits
+    bool continuousScroll : 1;          // 1 Bit
+    Color volumeMinColor;               // 24 Bits
+    Color volumeMaxColor;               // 24 Bits
+    Color mixChannelAColor;             // 24 Bits
+    Color mixChannelBColor;             // 24 Bits
+    LightingEffect muteEffect;          // 8 Bits - while the current session is muted
+    LightingEffect splashEffect;        // 8 Bits - on the splash screen
+    LightingEffect sleepEffect;         // 8 Bits - once the display goes to sleep
+    // 136 bits - 17 bytes
+
+    DeviceSettings() : sleepAfterSeconds(5), accelerationPercentage(60), continuousScroll(true),
+                 volumeMinColor(0, 0, 255), volumeMaxColor(255, 0, 0), mixChannelAColor(0, 0, 255), mixChannelBColor(255, 0, 255),
+                 muteEffect(LightingEffect::EFFECT_PULSE), splashEffect(LightingEffect::EFFECT_SPIN), sleepEffect(LightingEffect::EFFECT_FADE_OUT) {}
+};
+static_assert(sizeof(DeviceSettings) == 17, "Invalid Expected Message Size");
+
+struct __attribute__((__packed__)) ModeStates
+{
+    uint8_t states[DisplayMode::MODE_MAX]; // 40 bits
+    // 40 bits - 5 bytes
+
+    ModeStates() : states{0, 1, 1, 0, 0} {}
+    // states{STATE_LOGO, STATE_EDIT, STATE_EDIT, STATE_NAVIGATE, STATE_SELECT_A}
+};
+static_assert(sizeof(ModeStates) == 5, "Invalid Expected Message Size");
+
+struct __attribute__((__packed__)) ProbeData
+{
+    uint32_t hostTime;   // 32 bits - opaque host timestamp, echoed back untouched
+    uint32_t deviceTime; // 32 bits - device micros() when the probe was read
+    uint32_t queuedTime; // 32 bits - upper bound (us) the probe waited in the serial buffer
+    // 96 bits - 12 bytes
+
+    ProbeData() : hostTime(0), deviceTime(0), queuedTime(0) {}
+};
+static_assert(sizeof(ProbeData) == 12, "Invalid Expected Message Size");
+
+struct __attribute__((__packed__)) LinkStats
+{
+    uint32_t bytesRead;       // 32 bits
+    uint32_t bytesWritten;    // 32 bits
+    uint16_t framesRead;      // 16 bits
+    uint16_t framesWritten;   // 16 bits
+    uint16_t sizeErrors;      // 16 bits - payload shorter than expected when the serial timeout hit
+    uint16_t unknownCommands; // 16 bits - command byte outside of the Command range
+    uint16_t overflows;       // 16 bits - receive buffer found full, incoming bytes were likely dropped
+    // 144 bits - 18 bytes
+
+    LinkStats() : bytesRead(0), bytesWritten(0), framesRead(0), framesWritten(0), sizeErrors(0), unknownCommands(0), overflows(0) {}
+};
+static_assert(sizeof(LinkStats) == 18, "Invalid Expected Message Size");
+
+struct __attribute__((__packed__)) Diagnostics
+{
+    uint16_t encoderInvalid; // 16 bits - encoder samples where both pins changed, a quadrature state was missed
+    uint16_t timerMissed;    // 16 bits - Timer1 ticks that never ran
+    uint16_t timerLateMax;   // 16 bits - longest a Timer1 tick ran late (us), lower bound of the longest interrupts-off window
+    uint16_t pixelsShowMax;  // 16 bits - longest NeoPixel show() (us), interrupts are off for all of it
+    uint16_t inputOverflows; // 16 bits - input events dropped because loop() fell behind
+    // 80 bits - 10 bytes
+
+    Diagnostics() : encoderInvalid(0), timerMissed(0), timerLateMax(0), pixelsShowMax(0), inputOverflows(0) {}
+};
+static_assert(sizeof(Diagnostics) == 10, "Invalid Expected Message Size");
+
+struct __attribute__((__packed__)) PeakLevels
+{
+    uint8_t levels[2]; // 16 bits - 4 bits per SessionIndex, INDEX_CURRENT in the low bits of the first byte
+    // 16 bits - 2 bytes
+
+    PeakLevels() : levels{0} {}
+
+    // \returns [0..15]
+    uint8_t Get(SessionIndex index) const { return (levels[index >> 1] >> ((index & 1) * 4)) & 0x0F; }
+    void Set(SessionIndex index, uint8_t level)
+    {
+        uint8_t shift = (index & 1) * 4;
+        levels[index >> 1] = (levels[index >> 1] & ~(0x0F << shift)) | ((level & 0x0F) << shift);
+    }
+};
+static_assert(sizeof(PeakLevels) == 2, "Invalid Expected Message Size");
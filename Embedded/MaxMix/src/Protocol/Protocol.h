@@ -0,0 +1,12 @@
+#pragma once
+//********************************************************
+// PROJECT: MAXMIX
+//
+// DECRIPTION:
+// Header-only MaxMix protocol library.
+// Used by the firmware and by native tools, include with
+// -I Embedded/MaxMix/src and #include "Protocol/Protocol.h"
+//********************************************************
+
+#include "Messages.h"
+#include "Codec.h"
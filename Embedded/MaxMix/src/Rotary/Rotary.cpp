@@ -91,7 +91,10 @@ void Rotary::begin(bool pullup) {
 
 unsigned char Rotary::process() {
   // Grab state of input pins.
-  unsigned char pinstate = (digitalRead(pin2) << 1) | digitalRead(pin1);
+  return process((digitalRead(pin2) << 1) | digitalRead(pin1));
+}
+
+unsigned char Rotary::process(unsigned char pinstate) {
   // Determine new state from the pins and state table.
   state = ttable[state & 0xf][pinstate];
   // Return emit bits, ie the generated event.
@@ -23,6 +23,8 @@ class Rotary
   public:
     Rotary(char, char);
     unsigned char process();
+    // Same as process() with the pins already read, pinstate is (pin2 << 1) | pin1.
+    unsigned char process(unsigned char pinstate);
     void begin(bool pullup=true);
   private:
     unsigned char state;
@@ -614,6 +614,46 @@ class TimerOne
     static unsigned short pwmPeriod;
     static unsigned char clockSelectBits;
 
+#elif defined(MAXMIX_EMULATOR)
+
+  public:
+    //****************************
+    //  Configuration
+    //****************************
+    // Native builds: a host thread stands in for the timer, see Embedded/Native/Arduino/NativeTimerOne.cpp
+    void initialize(unsigned long microseconds=1000000) { setPeriod(microseconds); }
+    void setPeriod(unsigned long microseconds);
+
+    //****************************
+    //  Run Control
+    //****************************
+    void start();
+    void stop();
+    void restart() { start(); }
+    void resume() { start(); }
+
+    //****************************
+    //  Interrupt Function
+    //****************************
+    void attachInterrupt(void (*isr)()) {
+	isrCallback = isr;
+	start();
+    }
+    void attachInterrupt(void (*isr)(), unsigned long microseconds) {
+	if(microseconds > 0) setPeriod(microseconds);
+	attachInterrupt(isr);
+    }
+    void detachInterrupt() {
+	isrCallback = isrDefaultUnused;
+    }
+    static void (*isrCallback)();
+    static void isrDefaultUnused();
+
+  private:
+    // properties
+    static unsigned short pwmPeriod;
+    static unsigned char clockSelectBits;
+
 #endif
 };
 
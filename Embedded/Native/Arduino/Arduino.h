@@ -0,0 +1,77 @@
+#pragma once
+//********************************************************
+// PROJECT: MAXMIX
+//
+// DECRIPTION:
+// Minimal Arduino core for native (Linux) builds of the firmware.
+// Only what the firmware and its bundled libraries use is provided.
+// Timing and pin state are backed by the host, see Native.h.
+//********************************************************
+
+// Pull in every standard header before the Arduino macros below,
+// min/max/abs would otherwise break their declarations.
+#include <math.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "avr/interrupt.h"
+#include "avr/io.h"
+#include "avr/pgmspace.h"
+#include "pins_arduino.h"
+#include "WString.h"
+#include "HardwareSerial.h"
+
+//********************************************************
+// *** DEFINES
+//********************************************************
+#define HIGH 0x1
+#define LOW 0x0
+
+#define INPUT 0x0
+#define OUTPUT 0x1
+#define INPUT_PULLUP 0x2
+
+#define LSBFIRST 0
+#define MSBFIRST 1
+
+#define NUM_DIGITAL_PINS 32
+
+#define min(a, b) ((a) < (b) ? (a) : (b))
+#define max(a, b) ((a) > (b) ? (a) : (b))
+#define abs(x) ((x) > 0 ? (x) : -(x))
+#define constrain(amt, low, high) ((amt) < (low) ? (low) : ((amt) > (high) ? (high) : (amt)))
+
+#define _BV(bit) (1 << (bit))
+#define bit(b) (1UL << (b))
+#define lowByte(w) ((uint8_t)((w)&0xff))
+#define highByte(w) ((uint8_t)((w) >> 8))
+
+#define noInterrupts() cli()
+#define interrupts() sei()
+
+typedef bool boolean;
+typedef uint8_t byte;
+
+//********************************************************
+// *** FUNCTIONS
+//********************************************************
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t value);
+int digitalRead(uint8_t pin);
+
+// 32 bit like on AVR, so wrap around maths behaves the same.
+uint32_t millis(void);
+uint32_t micros(void);
+void delay(uint32_t ms);
+void delayMicroseconds(unsigned int us);
+void yield(void);
+
+void cli(void);
+void sei(void);
+
+long random(long howbig);
+long random(long howsmall, long howbig);
+void randomSeed(unsigned long seed);
@@ -0,0 +1,223 @@
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <random>
+#include <thread>
+
+#include "Arduino.h"
+#include "Native.h"
+#include "SPI.h"
+
+SPIClass SPI;
+
+//********************************************************
+// *** TIME
+//********************************************************
+static const std::chrono::steady_clock::time_point s_Start = std::chrono::steady_clock::now();
+
+static uint64_t ElapsedMicros(void)
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - s_Start).count();
+}
+
+uint32_t millis(void)
+{
+    return (uint32_t)(ElapsedMicros() / 1000);
+}
+
+uint32_t micros(void)
+{
+    return (uint32_t)ElapsedMicros();
+}
+
+void delay(uint32_t ms)
+{
+    std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+}
+
+void delayMicroseconds(unsigned int us)
+{
+    // Spin for short waits like the AVR busy loop, sleeping would overshoot by far more than the wait itself.
+    if (us > 200)
+    {
+        std::this_thread::sleep_for(std::chrono::microseconds(us));
+        return;
+    }
+    uint64_t end = ElapsedMicros() + us;
+    while (ElapsedMicros() < end)
+        ;
+}
+
+void yield(void)
+{
+    std::this_thread::yield();
+}
+
+//********************************************************
+// *** INTERRUPTS
+//********************************************************
+// Holding s_InterruptLock is "interrupts disabled". cli() does not nest on AVR and neither does this.
+static std::mutex s_InterruptLock;
+static thread_local bool t_Masked = false;
+
+void cli(void)
+{
+    if (t_Masked)
+        return;
+    s_InterruptLock.lock();
+    t_Masked = true;
+}
+
+void sei(void)
+{
+    if (!t_Masked)
+        return;
+    t_Masked = false;
+    s_InterruptLock.unlock();
+}
+
+//********************************************************
+// *** PINS
+//********************************************************
+volatile uint8_t PINB, PINC, PIND;
+volatile uint8_t PCICR, PCIFR, PCMSK0, PCMSK1, PCMSK2;
+
+extern "C" void Native_PCINT0_vect(void) __attribute__((weak));
+extern "C" void Native_PCINT1_vect(void) __attribute__((weak));
+extern "C" void Native_PCINT2_vect(void) __attribute__((weak));
+
+static std::atomic<uint8_t> s_PinLevel[NUM_DIGITAL_PINS];
+static std::atomic<bool> s_PinDriven[NUM_DIGITAL_PINS];
+
+// Updates the level and its port register bit.
+// \returns true if the pin changed and its pin change interrupt is enabled
+static bool SetLevel(uint8_t pin, uint8_t level)
+{
+    bool changed = s_PinLevel[pin].exchange(level) != level;
+    volatile uint8_t *port = portInputRegister(digitalPinToPort(pin));
+    if (port == NULL)
+        return false;
+
+    if (level)
+        *port |= digitalPinToBitMask(pin);
+    else
+        *port &= ~digitalPinToBitMask(pin);
+    return changed && (PCICR & _BV(digitalPinToPCICRbit(pin))) && (*digitalPinToPCMSK(pin) & _BV(digitalPinToPCMSKbit(pin)));
+}
+
+void pinMode(uint8_t pin, uint8_t mode)
+{
+    if (pin >= NUM_DIGITAL_PINS)
+        return;
+    if (mode == INPUT_PULLUP && !s_PinDriven[pin])
+        SetLevel(pin, HIGH);
+}
+
+void digitalWrite(uint8_t pin, uint8_t value)
+{
+    if (pin < NUM_DIGITAL_PINS)
+        SetLevel(pin, value ? HIGH : LOW);
+}
+
+int digitalRead(uint8_t pin)
+{
+    if (pin >= NUM_DIGITAL_PINS)
+        return LOW;
+    return s_PinLevel[pin];
+}
+
+//********************************************************
+// *** RANDOM
+//********************************************************
+static std::minstd_rand s_Random;
+
+long random(long howbig)
+{
+    if (howbig <= 0)
+        return 0;
+    return s_Random() % howbig;
+}
+
+long random(long howsmall, long howbig)
+{
+    if (howsmall >= howbig)
+        return howsmall;
+    return random(howbig - howsmall) + howsmall;
+}
+
+void randomSeed(unsigned long seed)
+{
+    s_Random.seed(seed);
+}
+
+//********************************************************
+// *** NATIVE
+//********************************************************
+namespace Native
+{
+    static I2CHandler s_I2CHandler;
+    static bool s_I2CWait = true;
+    static PixelsHandler s_PixelsHandler;
+
+    void SetPin(uint8_t pin, bool high)
+    {
+        if (pin >= NUM_DIGITAL_PINS)
+            return;
+
+        // The edge is seen with interrupts masked, its handler runs before they are enabled again.
+        cli();
+        s_PinDriven[pin] = true;
+        if (SetLevel(pin, high ? HIGH : LOW))
+        {
+            static void (*const vectors[])(void) = {Native_PCINT0_vect, Native_PCINT1_vect, Native_PCINT2_vect};
+            void (*isr)(void) = vectors[digitalPinToPCICRbit(pin)];
+            if (isr)
+                isr();
+        }
+        sei();
+    }
+
+    bool GetPin(uint8_t pin)
+    {
+        return digitalRead(pin) == HIGH;
+    }
+
+    void RunInterrupt(void (*isr)())
+    {
+        cli();
+        isr();
+        sei();
+    }
+
+    void SetI2CHandler(I2CHandler handler)
+    {
+        s_I2CHandler = handler;
+    }
+
+    void SetI2CWait(bool wait)
+    {
+        s_I2CWait = wait;
+    }
+
+    bool GetI2CWait()
+    {
+        return s_I2CWait;
+    }
+
+    void SetPixelsHandler(PixelsHandler handler)
+    {
+        s_PixelsHandler = handler;
+    }
+
+    void Transmit(uint8_t address, const uint8_t *data, size_t length)
+    {
+        if (s_I2CHandler)
+            s_I2CHandler(address, data, length);
+    }
+
+    void ShowPixels(const uint8_t *pixels, uint16_t length)
+    {
+        if (s_PixelsHandler)
+            s_PixelsHandler(pixels, length);
+    }
+} // namespace Native
@@ -0,0 +1,51 @@
+#include <mutex>
+
+#include "HardwareSerial.h"
+
+HardwareSerial Serial;
+
+// Receive ring is shared between the transport thread and the firmware.
+static std::mutex s_Lock;
+
+int HardwareSerial::available()
+{
+    std::lock_guard<std::mutex> lock(s_Lock);
+    return (SERIAL_RX_BUFFER_SIZE + head - tail) % SERIAL_RX_BUFFER_SIZE;
+}
+
+int HardwareSerial::peek()
+{
+    std::lock_guard<std::mutex> lock(s_Lock);
+    if (head == tail)
+        return -1;
+    return buffer[tail];
+}
+
+int HardwareSerial::read()
+{
+    std::lock_guard<std::mutex> lock(s_Lock);
+    if (head == tail)
+        return -1;
+    uint8_t data = buffer[tail];
+    tail = (tail + 1) % SERIAL_RX_BUFFER_SIZE;
+    return data;
+}
+
+size_t HardwareSerial::write(const uint8_t *data, size_t size)
+{
+    if (transmitHandler == 0)
+        return size;
+    return transmitHandler(data, size);
+}
+
+bool HardwareSerial::receive(uint8_t data)
+{
+    std::lock_guard<std::mutex> lock(s_Lock);
+    uint8_t next = (head + 1) % SERIAL_RX_BUFFER_SIZE;
+    // One slot is always kept free, same as the AVR core.
+    if (next == tail)
+        return false;
+    buffer[head] = data;
+    head = next;
+    return true;
+}
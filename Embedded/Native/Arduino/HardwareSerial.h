@@ -0,0 +1,41 @@
+#pragma once
+
+#include "Stream.h"
+
+// Same receive ring size as the AVR core, so overflow behaviour matches the device.
+#define SERIAL_RX_BUFFER_SIZE 64
+
+class HardwareSerial : public Stream
+{
+public:
+    typedef size_t (*TransmitHandler)(const uint8_t *buffer, size_t size);
+
+    HardwareSerial() : baudRate(0), head(0), tail(0), transmitHandler(0) {}
+
+    void begin(unsigned long baud) { baudRate = baud; }
+    void end() { baudRate = 0; }
+    unsigned long getBaudRate() const { return baudRate; }
+
+    int available() override;
+    int peek() override;
+    int read() override;
+    size_t write(uint8_t data) override { return write(&data, 1); }
+    size_t write(const uint8_t *buffer, size_t size) override;
+    using Print::write;
+    void flush() override {}
+    operator bool() { return true; }
+
+    // Native side, feeds the receive ring like the USART RX interrupt would.
+    // \returns false if the ring was full and the byte was dropped
+    bool receive(uint8_t data);
+    void setTransmitHandler(TransmitHandler handler) { transmitHandler = handler; }
+
+private:
+    unsigned long baudRate;
+    volatile uint8_t head;
+    volatile uint8_t tail;
+    uint8_t buffer[SERIAL_RX_BUFFER_SIZE];
+    TransmitHandler transmitHandler;
+};
+
+extern HardwareSerial Serial;
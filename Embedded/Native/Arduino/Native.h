@@ -0,0 +1,36 @@
+#pragma once
+//********************************************************
+// PROJECT: MAXMIX
+//
+// DECRIPTION:
+// Host side of the native Arduino core.
+// Lets tools drive pins, run interrupt handlers and observe
+// what the firmware sends to its peripherals.
+//********************************************************
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace Native
+{
+    typedef void (*I2CHandler)(uint8_t address, const uint8_t *data, size_t length);
+    typedef void (*PixelsHandler)(const uint8_t *pixels, uint16_t length);
+
+    // Drives an input pin from outside the firmware, like a switch or encoder contact would.
+    // Runs the pin change interrupt handler if the firmware enabled it for that pin.
+    void SetPin(uint8_t pin, bool high);
+    bool GetPin(uint8_t pin);
+
+    // Runs isr the way the MCU would: interrupts masked and never while the firmware is inside cli()/sei().
+    void RunInterrupt(void (*isr)());
+
+    void SetI2CHandler(I2CHandler handler);
+    // TwoWire holds the caller for as long as the bus would, tools that only count bytes can turn it off.
+    void SetI2CWait(bool wait);
+    bool GetI2CWait();
+    void SetPixelsHandler(PixelsHandler handler);
+
+    // Called by TwoWire and by the native branch of Adafruit_NeoPixel::show().
+    void Transmit(uint8_t address, const uint8_t *data, size_t length);
+    void ShowPixels(const uint8_t *pixels, uint16_t length);
+} // namespace Native
@@ -0,0 +1,49 @@
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#include "Arduino.h"
+#include "Native.h"
+#include "../../MaxMix/src/TimerOne/TimerOne.h"
+
+// Timer1 stand-in: a host thread raises the overflow interrupt every period.
+// Like the hardware, a tick that comes due while interrupts are masked waits,
+// and ticks missed while it waits collapse into that single pending one.
+static std::atomic<unsigned long> s_Period(1000000);
+static std::atomic<bool> s_Running(false);
+// Bumped on every start so a thread left over from a previous start/stop exits.
+static std::atomic<unsigned> s_Generation(0);
+
+static void TimerThread(unsigned generation)
+{
+    std::chrono::steady_clock::time_point next = std::chrono::steady_clock::now();
+    while (s_Running && s_Generation == generation)
+    {
+        std::chrono::microseconds period(s_Period.load());
+        next += period;
+        std::this_thread::sleep_until(next);
+
+        Native::RunInterrupt(TimerOne::isrCallback);
+
+        std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+        if (now > next + period)
+            next = now;
+    }
+}
+
+void TimerOne::setPeriod(unsigned long microseconds)
+{
+    s_Period = microseconds > 0 ? microseconds : 1;
+}
+
+void TimerOne::start()
+{
+    if (s_Running.exchange(true))
+        return;
+    std::thread(TimerThread, ++s_Generation).detach();
+}
+
+void TimerOne::stop()
+{
+    s_Running = false;
+}
@@ -0,0 +1,81 @@
+#include <stdio.h>
+#include <string.h>
+
+#include "Print.h"
+
+size_t Print::write(const uint8_t *buffer, size_t size)
+{
+    size_t count = 0;
+    while (size--)
+    {
+        if (!write(*buffer++))
+            break;
+        count++;
+    }
+    return count;
+}
+
+size_t Print::write(const char *str)
+{
+    return str == NULL ? 0 : write((const uint8_t *)str, strlen(str));
+}
+
+size_t Print::printNumber(unsigned long value, uint8_t base)
+{
+    char buffer[8 * sizeof(long) + 1];
+    char *str = &buffer[sizeof(buffer) - 1];
+    *str = '\0';
+
+    if (base < 2)
+        base = 10;
+
+    do
+    {
+        char c = value % base;
+        value /= base;
+        *--str = c < 10 ? c + '0' : c + 'A' - 10;
+    } while (value);
+
+    return write(str);
+}
+
+size_t Print::print(const __FlashStringHelper *str) { return write(reinterpret_cast<const char *>(str)); }
+size_t Print::print(const char str[]) { return write(str); }
+size_t Print::print(char c) { return write((uint8_t)c); }
+size_t Print::print(unsigned char value, int base) { return print((unsigned long)value, base); }
+size_t Print::print(int value, int base) { return print((long)value, base); }
+size_t Print::print(unsigned int value, int base) { return print((unsigned long)value, base); }
+
+size_t Print::print(long value, int base)
+{
+    if (base == 0)
+        return write((uint8_t)value);
+    if (base == 10 && value < 0)
+        return print('-') + printNumber(-value, 10);
+    return printNumber(value, base);
+}
+
+size_t Print::print(unsigned long value, int base)
+{
+    if (base == 0)
+        return write((uint8_t)value);
+    return printNumber(value, base);
+}
+
+size_t Print::print(double value, int digits)
+{
+    char buffer[32];
+    int length = snprintf(buffer, sizeof(buffer), "%.*f", digits, value);
+    return write((const uint8_t *)buffer, length);
+}
+
+size_t Print::println(void) { return write("\r\n"); }
+size_t Print::println(const __FlashStringHelper *str) { return print(str) + println(); }
+size_t Print::println(const char str[]) { return print(str) + println(); }
+size_t Print::println(char c) { return print(c) + println(); }
+size_t Print::println(unsigned char value, int base) { return print(value, base) + println(); }
+size_t Print::println(int value, int base) { return print(value, base) + println(); }
+size_t Print::println(unsigned int value, int base) { return print(value, base) + println(); }
+size_t Print::println(long value, int base) { return print(value, base) + println(); }
+size_t Print::println(unsigned long value, int base) { return print(value, base) + println(); }
+size_t Print::println(double value, int digits) { return print(value, digits) + println(); }
@@ -0,0 +1,14 @@
+#pragma once
+
+#include <stdint.h>
+
+// Only the I2C display is emulated, SPI exists so Adafruit_SSD1306 compiles.
+class SPIClass
+{
+public:
+    void begin() {}
+    void end() {}
+    uint8_t transfer(uint8_t data) { return data; }
+};
+
+extern SPIClass SPI;
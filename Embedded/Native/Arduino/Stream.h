@@ -0,0 +1,24 @@
+#pragma once
+
+#include "Print.h"
+
+class Stream : public Print
+{
+public:
+    Stream() : timeout(1000) {}
+
+    virtual int available() = 0;
+    virtual int read() = 0;
+    virtual int peek() = 0;
+
+    void setTimeout(unsigned long milliseconds) { timeout = milliseconds; }
+    unsigned long getTimeout(void) { return timeout; }
+
+    size_t readBytes(char *buffer, size_t length);
+    size_t readBytes(uint8_t *buffer, size_t length) { return readBytes((char *)buffer, length); }
+
+protected:
+    int timedRead();
+
+    unsigned long timeout;
+};
@@ -0,0 +1,22 @@
+#pragma once
+//********************************************************
+// PROJECT: MAXMIX
+//
+// DECRIPTION:
+// Read-only stand-in for the Arduino String class, only
+// what Adafruit_GFX needs to compile.
+//********************************************************
+
+#include <string.h>
+
+class String
+{
+public:
+    String(const char *str = "") : buffer(str) {}
+
+    unsigned int length() const { return strlen(buffer); }
+    const char *c_str() const { return buffer; }
+
+private:
+    const char *buffer;
+};
@@ -0,0 +1,39 @@
+#include "Arduino.h"
+#include "Native.h"
+#include "Wire.h"
+
+TwoWire Wire;
+
+void TwoWire::beginTransmission(uint8_t value)
+{
+    address = value;
+    length = 0;
+}
+
+uint8_t TwoWire::endTransmission(bool sendStop)
+{
+    (void)sendStop;
+    Native::Transmit(address, buffer, length);
+
+    // Hold the caller for as long as the bus would: 9 clocks per byte including the address.
+    if (Native::GetI2CWait())
+        delayMicroseconds((uint32_t)(length + 1) * 9 * 1000000UL / clock);
+    length = 0;
+    return 0;
+}
+
+size_t TwoWire::write(uint8_t data)
+{
+    if (length >= BUFFER_LENGTH)
+        return 0;
+    buffer[length++] = data;
+    return 1;
+}
+
+size_t TwoWire::write(const uint8_t *data, size_t size)
+{
+    size_t count = 0;
+    while (count < size && write(data[count]))
+        count++;
+    return count;
+}
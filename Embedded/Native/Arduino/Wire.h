@@ -0,0 +1,35 @@
+#pragma once
+
+#include "Stream.h"
+
+#define BUFFER_LENGTH 32
+
+class TwoWire : public Stream
+{
+public:
+    TwoWire() : clock(100000), address(0), length(0) {}
+
+    void begin() {}
+    void end() {}
+    void setClock(uint32_t frequency) { clock = frequency; }
+
+    void beginTransmission(uint8_t address);
+    uint8_t endTransmission(bool sendStop = true);
+
+    size_t write(uint8_t data) override;
+    size_t write(const uint8_t *data, size_t size) override;
+    using Print::write;
+
+    // Reading from peripherals is not emulated.
+    int available() override { return 0; }
+    int read() override { return -1; }
+    int peek() override { return -1; }
+
+private:
+    uint32_t clock;
+    uint8_t address;
+    uint8_t length;
+    uint8_t buffer[BUFFER_LENGTH];
+};
+
+extern TwoWire Wire;
@@ -0,0 +1,5 @@
+#pragma once
+
+#include "io.h"
+
+#define ISR(vector) extern "C" void vector(void)
@@ -0,0 +1,35 @@
+#pragma once
+//********************************************************
+// PROJECT: MAXMIX
+//
+// DECRIPTION:
+// ATmega328P registers the firmware touches directly.
+// Port input registers follow the pin levels, the pin change
+// interrupt registers decide whether Native::SetPin runs the
+// PCINTn_vect handlers.
+//********************************************************
+
+#include <stdint.h>
+
+#ifndef _BV
+#define _BV(bit) (1 << (bit))
+#endif
+
+extern volatile uint8_t PINB;
+extern volatile uint8_t PINC;
+extern volatile uint8_t PIND;
+
+extern volatile uint8_t PCICR;
+extern volatile uint8_t PCIFR;
+extern volatile uint8_t PCMSK0;
+extern volatile uint8_t PCMSK1;
+extern volatile uint8_t PCMSK2;
+
+#define PCIE0 0
+#define PCIE1 1
+#define PCIE2 2
+
+// Interrupt vectors are plain functions on the host, Core.cpp references them weakly.
+#define PCINT0_vect Native_PCINT0_vect
+#define PCINT1_vect Native_PCINT1_vect
+#define PCINT2_vect Native_PCINT2_vect
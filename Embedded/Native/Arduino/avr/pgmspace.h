@@ -0,0 +1,20 @@
+#pragma once
+
+#include <stdint.h>
+#include <string.h>
+
+// Flash and RAM share one address space on the host.
+#define PROGMEM
+#define PGM_P const char *
+#define PSTR(s) (s)
+
+// Token-for-token identical to the fallback in Adafruit_SSD1306.cpp so redefining it is not a warning.
+#define pgm_read_byte(addr) \
+  (*(const unsigned char *)(addr))
+#define pgm_read_word(addr) (*(const unsigned short *)(addr))
+#define pgm_read_dword(addr) (*(const uint32_t *)(addr))
+#define pgm_read_ptr(addr) (*(void *const *)(addr))
+
+#define memcpy_P memcpy
+#define strlen_P strlen
+#define strcpy_P strcpy
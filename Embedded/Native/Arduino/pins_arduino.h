@@ -0,0 +1,24 @@
+#pragma once
+//********************************************************
+// PROJECT: MAXMIX
+//
+// DECRIPTION:
+// Pin mapping of the Nano (ATmega328P), same as the AVR core
+// standard variant: D0-D7 port D, D8-D13 port B, A0-A5 port C.
+//********************************************************
+
+#include "avr/io.h"
+
+#define NOT_A_PORT 0
+#define PB 2
+#define PC 3
+#define PD 4
+
+#define digitalPinToPort(p) (((p) <= 7) ? PD : (((p) <= 13) ? PB : (((p) <= 19) ? PC : NOT_A_PORT)))
+#define digitalPinToBitMask(p) _BV(digitalPinToPCMSKbit(p))
+#define portInputRegister(port) ((port) == PB ? &PINB : ((port) == PC ? &PINC : ((port) == PD ? &PIND : (volatile uint8_t *)0)))
+
+#define digitalPinToPCICR(p) (((p) >= 0 && (p) <= 21) ? (&PCICR) : ((volatile uint8_t *)0))
+#define digitalPinToPCICRbit(p) (((p) <= 7) ? 2 : (((p) <= 13) ? 0 : 1))
+#define digitalPinToPCMSK(p) (((p) <= 7) ? (&PCMSK2) : (((p) <= 13) ? (&PCMSK0) : (((p) <= 21) ? (&PCMSK1) : ((volatile uint8_t *)0))))
+#define digitalPinToPCMSKbit(p) (((p) <= 7) ? (p) : (((p) <= 13) ? ((p)-8) : ((p)-14)))
@@ -0,0 +1,6 @@
+#pragma once
+
+#include "../Arduino.h"
+
+#define _delay_ms(ms) delay(ms)
+#define _delay_us(us) delayMicroseconds(us)
@@ -0,0 +1,157 @@
+#include <atomic>
+#include <chrono>
+#include <stdio.h>
+#include <termios.h>
+#include <thread>
+#include <unistd.h>
+
+#include "Native.h"
+#include "Input.h"
+
+namespace Input
+{
+    // Hold each quadrature state for a few 1 ms samples so builds that poll the encoder see every edge,
+    // a fast spin still fits ~60 detents/s.
+    static const std::chrono::milliseconds STEP_TIME(3);
+    static const std::chrono::milliseconds DETENT_GAP(4);
+    static const std::chrono::milliseconds SPIN_GAP(1);
+    static const std::chrono::milliseconds TAP_TIME(60);
+    static const std::chrono::milliseconds DOUBLETAP_GAP(60);
+    static const std::chrono::milliseconds HOLD_TIME(700);
+    static const std::chrono::milliseconds SCRIPT_WAIT(100);
+
+    static uint8_t s_PinA, s_PinB, s_PinSwitch;
+    static std::atomic<bool> s_Quit(false);
+    static bool s_RawTerminal;
+    static termios s_SavedTerminal;
+
+    static void Wait(std::chrono::milliseconds time)
+    {
+        std::this_thread::sleep_for(time);
+    }
+
+    // One full quadrature cycle from the idle 11 state. Levels are {A, B}.
+    static void Detent(bool clockwise)
+    {
+        static const bool cw[4][2] = {{false, true}, {false, false}, {true, false}, {true, true}};
+        static const bool ccw[4][2] = {{true, false}, {false, false}, {false, true}, {true, true}};
+        const bool(*sequence)[2] = clockwise ? cw : ccw;
+        for (uint8_t i = 0; i < 4; i++)
+        {
+            Native::SetPin(s_PinA, sequence[i][0]);
+            Native::SetPin(s_PinB, sequence[i][1]);
+            Wait(STEP_TIME);
+        }
+    }
+
+    static void Press(std::chrono::milliseconds time)
+    {
+        // Switch is active low with the internal pull-up.
+        Native::SetPin(s_PinSwitch, false);
+        Wait(time);
+        Native::SetPin(s_PinSwitch, true);
+    }
+
+    static void Handle(int key)
+    {
+        switch (key)
+        {
+        case 'd':
+            Detent(true);
+            Wait(DETENT_GAP);
+            break;
+        case 'a':
+            Detent(false);
+            Wait(DETENT_GAP);
+            break;
+        case 'D':
+        case 'A':
+            for (uint8_t i = 0; i < 10; i++)
+            {
+                Detent(key == 'D');
+                Wait(SPIN_GAP);
+            }
+            break;
+        case ' ':
+            Press(TAP_TIME);
+            break;
+        case 'x':
+            Press(TAP_TIME);
+            Wait(DOUBLETAP_GAP);
+            Press(TAP_TIME);
+            break;
+        case 'h':
+            Press(HOLD_TIME);
+            break;
+        case '.':
+            Wait(SCRIPT_WAIT);
+            break;
+        case 'q':
+            s_Quit = true;
+            break;
+        }
+    }
+
+    static void InputThread(void)
+    {
+        int escape = 0;
+        while (!s_Quit)
+        {
+            int key = getchar();
+            if (key == EOF)
+                break;
+
+            // Arrow keys arrive as ESC [ C / ESC [ D
+            if (key == 0x1B)
+            {
+                escape = 1;
+                continue;
+            }
+            if (escape == 1)
+            {
+                escape = key == '[' ? 2 : 0;
+                continue;
+            }
+            if (escape == 2)
+            {
+                escape = 0;
+                key = key == 'C' ? 'd' : key == 'D' ? 'a' : 0;
+            }
+            Handle(key);
+        }
+    }
+
+    void Start(uint8_t pinA, uint8_t pinB, uint8_t pinSwitch)
+    {
+        s_PinA = pinA;
+        s_PinB = pinB;
+        s_PinSwitch = pinSwitch;
+        Native::SetPin(s_PinA, true);
+        Native::SetPin(s_PinB, true);
+        Native::SetPin(s_PinSwitch, true);
+
+        if (isatty(STDIN_FILENO))
+        {
+            termios tio;
+            tcgetattr(STDIN_FILENO, &s_SavedTerminal);
+            tio = s_SavedTerminal;
+            tio.c_lflag &= ~(ICANON | ECHO);
+            tcsetattr(STDIN_FILENO, TCSANOW, &tio);
+            s_RawTerminal = true;
+        }
+
+        std::thread(InputThread).detach();
+    }
+
+    void Stop(void)
+    {
+        if (s_RawTerminal)
+            tcsetattr(STDIN_FILENO, TCSANOW, &s_SavedTerminal);
+        s_RawTerminal = false;
+    }
+
+    bool QuitRequested(void)
+    {
+        return s_Quit;
+    }
+} // namespace Input
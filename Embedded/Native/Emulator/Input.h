@@ -0,0 +1,26 @@
+#pragma once
+//********************************************************
+// PROJECT: MAXMIX
+//
+// DECRIPTION:
+// Turns key presses (or a piped script) into encoder and
+// switch pin transitions for the emulated device.
+//
+//   d / right arrow  clockwise detent
+//   a / left arrow   counter-clockwise detent
+//   D / A            fast spin, 10 detents
+//   space            tap
+//   x                double tap
+//   h                hold
+//   .                wait 100 ms (scripts)
+//   q                quit
+//********************************************************
+
+#include <stdint.h>
+
+namespace Input
+{
+    void Start(uint8_t pinA, uint8_t pinB, uint8_t pinSwitch);
+    void Stop(void);
+    bool QuitRequested(void);
+} // namespace Input
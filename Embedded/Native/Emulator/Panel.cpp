@@ -0,0 +1,138 @@
+#include <mutex>
+#include <string.h>
+
+#include "Panel.h"
+
+namespace Panel
+{
+    static const uint8_t ADDRESS = 0x3C;
+    static const uint8_t CONTROL_COMMAND = 0x00;
+    static const uint8_t CONTROL_DATA = 0x40;
+
+    static std::mutex s_Lock;
+    static uint8_t s_Ram[PAGES][WIDTH];
+    static bool s_On;
+    static uint32_t s_Changes;
+
+    // Horizontal addressing window and cursor
+    static uint8_t s_ColumnStart, s_ColumnEnd = WIDTH - 1, s_Column;
+    static uint8_t s_PageStart, s_PageEnd = PAGES - 1, s_Page;
+
+    // Commands can be split over several transmissions, keep the partial one around.
+    static uint8_t s_Command;
+    static uint8_t s_Arguments[6];
+    static uint8_t s_ArgumentCount, s_ArgumentsExpected;
+
+    static uint8_t ArgumentCount(uint8_t command)
+    {
+        switch (command)
+        {
+        case 0x20: // Memory mode
+        case 0x81: // Contrast
+        case 0x8D: // Charge pump
+        case 0xA8: // Multiplex
+        case 0xD3: // Display offset
+        case 0xD5: // Clock divide
+        case 0xD9: // Precharge
+        case 0xDA: // COM pins
+        case 0xDB: // VCOM detect
+            return 1;
+        case 0x21: // Column address
+        case 0x22: // Page address
+        case 0xA3: // Vertical scroll area
+            return 2;
+        case 0x29: // Vertical & horizontal scroll
+        case 0x2A:
+            return 5;
+        case 0x26: // Horizontal scroll
+        case 0x27:
+            return 6;
+        default:
+            return 0;
+        }
+    }
+
+    static void Execute(void)
+    {
+        switch (s_Command)
+        {
+        case 0x21:
+            s_ColumnStart = s_Arguments[0] % WIDTH;
+            s_ColumnEnd = s_Arguments[1] < WIDTH ? s_Arguments[1] : WIDTH - 1;
+            s_Column = s_ColumnStart;
+            break;
+        case 0x22:
+            s_PageStart = s_Arguments[0] % PAGES;
+            s_PageEnd = s_Arguments[1] < PAGES ? s_Arguments[1] : PAGES - 1;
+            s_Page = s_PageStart;
+            break;
+        case 0xAE:
+            s_On = false;
+            s_Changes++;
+            break;
+        case 0xAF:
+            s_On = true;
+            s_Changes++;
+            break;
+        }
+    }
+
+    static void Command(uint8_t data)
+    {
+        if (s_ArgumentsExpected > s_ArgumentCount)
+        {
+            s_Arguments[s_ArgumentCount++] = data;
+        }
+        else
+        {
+            s_Command = data;
+            s_ArgumentCount = 0;
+            s_ArgumentsExpected = ArgumentCount(data);
+        }
+
+        if (s_ArgumentCount == s_ArgumentsExpected)
+        {
+            Execute();
+            s_ArgumentsExpected = 0;
+            s_ArgumentCount = 0;
+        }
+    }
+
+    static void Data(uint8_t data)
+    {
+        s_Ram[s_Page][s_Column] = data;
+        if (s_Column++ >= s_ColumnEnd)
+        {
+            s_Column = s_ColumnStart;
+            if (s_Page++ >= s_PageEnd)
+                s_Page = s_PageStart;
+        }
+    }
+
+    void Receive(uint8_t address, const uint8_t *data, size_t length)
+    {
+        if (address != ADDRESS || length == 0)
+            return;
+
+        std::lock_guard<std::mutex> lock(s_Lock);
+        if (data[0] == CONTROL_COMMAND)
+        {
+            for (size_t i = 1; i < length; i++)
+                Command(data[i]);
+        }
+        else if (data[0] == CONTROL_DATA)
+        {
+            for (size_t i = 1; i < length; i++)
+                Data(data[i]);
+            s_Changes++;
+        }
+    }
+
+    uint32_t Snapshot(uint8_t ram[PAGES][WIDTH], bool &on)
+    {
+        std::lock_guard<std::mutex> lock(s_Lock);
+        memcpy(ram, s_Ram, sizeof(s_Ram));
+        on = s_On;
+        return s_Changes;
+    }
+} // namespace Panel
@@ -0,0 +1,25 @@
+#pragma once
+//********************************************************
+// PROJECT: MAXMIX
+//
+// DECRIPTION:
+// SSD1306 model fed with the I2C stream the firmware sends.
+// Decodes the command/data control bytes into display RAM
+// so the emulator can show what the real panel would.
+//********************************************************
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace Panel
+{
+    static const uint8_t WIDTH = 128;
+    static const uint8_t HEIGHT = 32;
+    static const uint8_t PAGES = HEIGHT / 8;
+
+    // Native::I2CHandler
+    void Receive(uint8_t address, const uint8_t *data, size_t length);
+
+    // Copies display RAM, page major like the controller. \returns change counter
+    uint32_t Snapshot(uint8_t ram[PAGES][WIDTH], bool &on);
+} // namespace Panel
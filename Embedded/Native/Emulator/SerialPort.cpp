@@ -0,0 +1,136 @@
+#include <atomic>
+#include <chrono>
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+#include <termios.h>
+#include <thread>
+#include <unistd.h>
+
+#include "Arduino.h"
+#include "SerialPort.h"
+
+namespace SerialPort
+{
+    static int s_Master = -1;
+    // Kept open so reads on the master do not fail with EIO while no host is connected.
+    static int s_Slave = -1;
+    static std::string s_Path;
+    static std::string s_Link;
+    static std::atomic<bool> s_Receiving(false);
+
+    bool Open(const char *link)
+    {
+        s_Master = posix_openpt(O_RDWR | O_NOCTTY);
+        if (s_Master < 0 || grantpt(s_Master) != 0 || unlockpt(s_Master) != 0)
+        {
+            perror("posix_openpt");
+            return false;
+        }
+
+        s_Path = ptsname(s_Master);
+        s_Slave = open(s_Path.c_str(), O_RDWR | O_NOCTTY);
+        if (s_Slave < 0)
+        {
+            perror("open");
+            return false;
+        }
+
+        // Raw 8N1, no echo or line discipline, like a USB serial adapter.
+        termios tio;
+        tcgetattr(s_Slave, &tio);
+        cfmakeraw(&tio);
+        tcsetattr(s_Slave, TCSANOW, &tio);
+
+        // The firmware must never block on a host that is not reading.
+        fcntl(s_Master, F_SETFL, fcntl(s_Master, F_GETFL) | O_NONBLOCK);
+
+        if (link != NULL)
+        {
+            unlink(link);
+            if (symlink(s_Path.c_str(), link) != 0)
+            {
+                perror("symlink");
+                return false;
+            }
+            s_Link = link;
+        }
+        return true;
+    }
+
+    void Close(void)
+    {
+        s_Receiving = false;
+        if (!s_Link.empty())
+            unlink(s_Link.c_str());
+        if (s_Slave >= 0)
+            close(s_Slave);
+        if (s_Master >= 0)
+            close(s_Master);
+        s_Slave = s_Master = -1;
+    }
+
+    const char *GetPath(void)
+    {
+        return s_Path.c_str();
+    }
+
+    size_t Transmit(const uint8_t *buffer, size_t size)
+    {
+        // A device with nobody listening still "sends", bytes that do not fit are lost.
+        if (s_Master >= 0)
+            (void)write(s_Master, buffer, size);
+        return size;
+    }
+
+    static void ReceiveThread(void)
+    {
+        std::chrono::steady_clock::time_point next = std::chrono::steady_clock::now();
+        uint8_t buffer[256];
+        while (s_Receiving)
+        {
+            pollfd fd = {s_Master, POLLIN, 0};
+            if (poll(&fd, 1, 100) <= 0)
+                continue;
+
+            ssize_t count = read(s_Master, buffer, sizeof(buffer));
+            if (count <= 0)
+            {
+                if (count < 0 && errno != EAGAIN && errno != EIO)
+                    break;
+                // EIO: host hung up, wait for the next one.
+                std::this_thread::sleep_for(std::chrono::milliseconds(10));
+                continue;
+            }
+
+            unsigned long baudRate = Serial.getBaudRate();
+            // Serial.begin() has not been called yet, the UART is off.
+            if (baudRate == 0)
+                continue;
+
+            // 8N1: 10 bits on the wire per byte.
+            std::chrono::microseconds byteTime(10 * 1000000UL / baudRate);
+            std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+            if (next < now)
+                next = now;
+
+            for (ssize_t i = 0; i < count; i++)
+            {
+                next += byteTime;
+                std::this_thread::sleep_until(next);
+                // Dropped bytes are what the firmware's overflow counter is there to catch.
+                Serial.receive(buffer[i]);
+            }
+        }
+    }
+
+    void StartReceive(void)
+    {
+        if (s_Receiving.exchange(true))
+            return;
+        std::thread(ReceiveThread).detach();
+    }
+} // namespace SerialPort
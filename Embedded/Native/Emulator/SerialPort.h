@@ -0,0 +1,26 @@
+#pragma once
+//********************************************************
+// PROJECT: MAXMIX
+//
+// DECRIPTION:
+// Exposes the emulated Serial on a pseudo-terminal.
+// Host software opens the slave side exactly like the
+// CH340 port of a real device.
+//********************************************************
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace SerialPort
+{
+    // \param link - optional symlink to create to the slave device, can be NULL
+    bool Open(const char *link);
+    void Close(void);
+    const char *GetPath(void);
+
+    // HardwareSerial::TransmitHandler
+    size_t Transmit(const uint8_t *buffer, size_t size);
+
+    // Starts feeding received bytes into Serial at the rate set by Serial.begin().
+    void StartReceive(void);
+} // namespace SerialPort
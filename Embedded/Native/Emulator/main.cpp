@@ -0,0 +1,148 @@
+//********************************************************
+// PROJECT: MAXMIX
+//
+// DECRIPTION:
+// Native device emulator. Runs the unmodified firmware sketch
+// against the Native Arduino core and exposes its Serial on a
+// pseudo-terminal, so host software can connect to it like a
+// real device.
+//
+// USAGE:
+// maxmix-emulator [--link PATH] [--show]
+//   --link PATH  also expose the port as a symlink at PATH
+//   --show       draw the OLED and LED ring on stderr
+//********************************************************
+#include <atomic>
+#include <chrono>
+#include <signal.h>
+#include <stdio.h>
+#include <string.h>
+#include <thread>
+
+#include "Config.h"
+#include "Native.h"
+#include "Input.h"
+#include "Panel.h"
+#include "SerialPort.h"
+
+// Defined by the sketch
+void setup();
+void loop();
+
+static std::atomic<bool> s_Quit(false);
+static std::atomic<uint32_t> s_PixelFrames(0);
+static uint8_t s_Pixels[PIXELS_COUNT * 3];
+
+static void OnSignal(int)
+{
+    s_Quit = true;
+}
+
+static void OnPixels(const uint8_t *pixels, uint16_t length)
+{
+    // Called with interrupts masked, the copy is atomic with respect to the render thread.
+    if (length > sizeof(s_Pixels))
+        length = sizeof(s_Pixels);
+    memcpy(s_Pixels, pixels, length);
+    s_PixelFrames++;
+}
+
+//---------------------------------------------------------
+// Draws the panel with braille cells (2x4 pixels each) and the ring as coloured dots.
+// The panel is mounted upside down on the device (setRotation(2)), flip it back here.
+//---------------------------------------------------------
+static void Render(void)
+{
+    uint8_t ram[Panel::PAGES][Panel::WIDTH];
+    bool on;
+    Panel::Snapshot(ram, on);
+
+    uint8_t pixels[sizeof(s_Pixels)];
+    cli();
+    memcpy(pixels, s_Pixels, sizeof(pixels));
+    sei();
+
+    static const uint8_t dots[4][2] = {{0x01, 0x08}, {0x02, 0x10}, {0x04, 0x20}, {0x40, 0x80}};
+    fputs("\x1b[H", stderr);
+    for (uint8_t row = 0; row < Panel::HEIGHT; row += 4)
+    {
+        for (uint8_t column = 0; column < Panel::WIDTH; column += 2)
+        {
+            uint16_t cell = 0x2800;
+            for (uint8_t dy = 0; dy < 4; dy++)
+            {
+                for (uint8_t dx = 0; dx < 2; dx++)
+                {
+                    uint8_t x = Panel::WIDTH - 1 - (column + dx);
+                    uint8_t y = Panel::HEIGHT - 1 - (row + dy);
+                    if (on && (ram[y / 8][x] & (1 << (y % 8))))
+                        cell |= dots[dy][dx];
+                }
+            }
+            // UTF-8 encode, braille cells are all 3 bytes.
+            fputc(0xE0 | (cell >> 12), stderr);
+            fputc(0x80 | ((cell >> 6) & 0x3F), stderr);
+            fputc(0x80 | (cell & 0x3F), stderr);
+        }
+        fputs("\x1b[K\n", stderr);
+    }
+
+    // NEO_GRB byte order
+    for (uint8_t i = 0; i < PIXELS_COUNT; i++)
+        fprintf(stderr, "\x1b[38;2;%u;%u;%um● \x1b[0m", pixels[i * 3 + 1], pixels[i * 3], pixels[i * 3 + 2]);
+    fputs("\x1b[K\n", stderr);
+    fflush(stderr);
+}
+
+static void RenderThread(void)
+{
+    fputs("\x1b[2J", stderr);
+    while (!s_Quit)
+    {
+        Render();
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    }
+}
+
+int main(int argc, char **argv)
+{
+    const char *link = NULL;
+    bool show = false;
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--link") == 0 && i + 1 < argc)
+            link = argv[++i];
+        else if (strcmp(argv[i], "--show") == 0)
+            show = true;
+        else
+        {
+            fprintf(stderr, "usage: %s [--link PATH] [--show]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    if (!SerialPort::Open(link))
+        return 1;
+    fprintf(stderr, "MaxMix emulator on %s%s%s\n", SerialPort::GetPath(), link ? " -> " : "", link ? link : "");
+
+    signal(SIGINT, OnSignal);
+    signal(SIGTERM, OnSignal);
+
+    Serial.setTransmitHandler(SerialPort::Transmit);
+    Native::SetI2CHandler(Panel::Receive);
+    Native::SetPixelsHandler(OnPixels);
+    Input::Start(PIN_ENCODER_OUTA, PIN_ENCODER_OUTB, PIN_ENCODER_SWITCH);
+
+    setup();
+    SerialPort::StartReceive();
+    if (show)
+        std::thread(RenderThread).detach();
+
+    while (!s_Quit && !Input::QuitRequested())
+        loop();
+
+    s_Quit = true;
+    Input::Stop();
+    SerialPort::Close();
+    return 0;
+}
@@ -0,0 +1,182 @@
+//********************************************************
+// PROJECT: MAXMIX
+//
+// DECRIPTION:
+// Compares the firmware's table based encoder acceleration
+// with the fixed point formula it replaced. Reports host
+// cycles per call, the cost of rebuilding a table and how far
+// the quadratic table is from the exact formula. Exits with 1
+// if a 1ms bucket doesn't give the formula's step.
+// The host cycles don't show the gain: optimized, both paths
+// take a few tens of cycles, as the host multiplies and
+// divides 64 bit integers in hardware. Unoptimized builds
+// inflate the formula by an order of magnitude, the benchmark
+// warns about those. On AVR every SQ15x16 multiply and divide widens to 64
+// bits, the formula makes three of each per detent and they
+// are libgcc calls, the divides bit by bit. The table is a
+// bucket search and a byte read.
+//
+// USAGE:
+// acceleration-benchmark [ITERATIONS]
+//********************************************************
+#include <stdio.h>
+#include <stdlib.h>
+#include <random>
+#include <vector>
+
+#include "Ticks.h"
+#include "Config.h"
+
+// Defined in MaxMix.ino
+extern DeviceSettings g_Settings;
+extern int8_t g_PreviousSteps;
+void BuildAccelerationTable(AccelerationCurve curve, uint8_t percentage);
+int8_t ComputeAcceleratedVolume(int8_t encoderDelta, uint16_t deltaTime, int16_t volume);
+
+static const char *k_CurveNames[] = {"linear", "quadratic", "exponential"};
+
+// ComputeAcceleratedVolume before the table, speed squared in fixed point.
+static int8_t s_ReferencePreviousSteps;
+static int8_t ReferenceAcceleratedVolume(int8_t encoderDelta, uint32_t deltaTime, int16_t volume)
+{
+    if (encoderDelta == 0)
+        return volume;
+
+    bool dirChanged = (s_ReferencePreviousSteps & 0x80) != (encoderDelta & 0x80);
+
+    uint32_t step = 1;
+    if (!dirChanged)
+    {
+        SQ15x16 speed = (SQ15x16)encoderDelta * 1000 / deltaTime;
+        SQ15x16 accelerationDivisor = max((1 - (SQ15x16)g_Settings.accelerationPercentage / 100) * ROTARY_ACCELERATION_DIVISOR_MAX, 1);
+        SQ15x16 fstep = 1 + absFixed(speed * speed / accelerationDivisor);
+        step = fstep.getInteger();
+    }
+
+    s_ReferencePreviousSteps = encoderDelta;
+
+    if (encoderDelta > 0)
+        volume += step;
+    else
+        volume -= step;
+
+    return constrain(volume, 0, 100);
+}
+
+struct Detent
+{
+    int8_t direction;
+    uint16_t interval;
+};
+
+int main(int argc, char **argv)
+{
+    uint32_t iterations = argc > 1 ? strtoul(argv[1], NULL, 10) : 10000000;
+
+    // Mostly steady spins with the odd direction change, intervals as the smoothing produces them.
+    std::mt19937 random(1);
+    std::vector<Detent> detents(4096);
+    int8_t direction = 1;
+    for (Detent &detent : detents)
+    {
+        if (random() % 16 == 0)
+            direction = -direction;
+        detent.direction = direction;
+        detent.interval = 1 + random() % ROTARY_VELOCITY_RESET;
+    }
+
+    g_Settings = DeviceSettings();
+    BuildAccelerationTable(ROTARY_ACCELERATION_CURVE, g_Settings.accelerationPercentage);
+
+    // Same inputs through both, the sum keeps the calls from being optimized away.
+    volatile int32_t sink = 0;
+    int32_t sum = 0;
+    int16_t volume = 50;
+    uint64_t start = Ticks();
+    for (uint32_t i = 0; i < iterations; i++)
+    {
+        const Detent &detent = detents[i & (detents.size() - 1)];
+        volume = ReferenceAcceleratedVolume(detent.direction, detent.interval, volume);
+        sum += volume;
+    }
+    double reference = (double)(Ticks() - start) / iterations;
+    sink = sum;
+
+    sum = 0;
+    volume = 50;
+    start = Ticks();
+    for (uint32_t i = 0; i < iterations; i++)
+    {
+        const Detent &detent = detents[i & (detents.size() - 1)];
+        volume = ComputeAcceleratedVolume(detent.direction, detent.interval, volume);
+        sum += volume;
+    }
+    double table = (double)(Ticks() - start) / iterations;
+    sink = sum;
+    (void)sink;
+
+    uint32_t builds = iterations / 1000 + 1;
+    start = Ticks();
+    for (uint32_t i = 0; i < builds; i++)
+        BuildAccelerationTable((AccelerationCurve)(i % 3), i % 128);
+    double build = (double)(Ticks() - start) / builds;
+
+    // Quadratic table against the formula, for every setting and every interval of every bucket.
+    // Buckets under 16ms are 1ms wide and must give the formula's step, wider ones hold the
+    // step of their middle. Under 6ms speed squared overflows SQ15x16 and the formula wraps
+    // around, the table doesn't.
+    const uint16_t k_FirstExactInterval = 6;
+    const uint16_t k_FirstWideInterval = 16;
+    uint32_t samples[2] = {0}, mismatches[2] = {0}, maxError[2] = {0}, maxErrorInterval[2] = {0};
+    for (uint8_t percentage = 0; percentage < 128; percentage++)
+    {
+        g_Settings.accelerationPercentage = percentage;
+        BuildAccelerationTable(AccelerationCurve::CURVE_QUADRATIC, percentage);
+        for (uint16_t interval = k_FirstExactInterval; interval <= ROTARY_VELOCITY_RESET; interval++)
+        {
+            // From 0 going up, so the step is the new volume, direction unchanged.
+            s_ReferencePreviousSteps = 1;
+            g_PreviousSteps = 1;
+            int32_t expected = ReferenceAcceleratedVolume(1, interval, 0);
+            int32_t actual = ComputeAcceleratedVolume(1, interval, 0);
+            uint32_t error = abs(expected - actual);
+            uint8_t wide = interval >= k_FirstWideInterval;
+            samples[wide]++;
+            mismatches[wide] += error != 0;
+            if (error > maxError[wide])
+            {
+                maxError[wide] = error;
+                maxErrorInterval[wide] = interval;
+            }
+        }
+    }
+
+#ifndef __OPTIMIZE__
+    printf("Unoptimized build, the cycles say nothing about the firmware.\n\n");
+#endif
+    printf("%-20s %12s\n", "", "cycles/call");
+    printf("%-20s %12.1f\n", "fixed point", reference);
+    printf("%-20s %12.1f\n", "table", table);
+    printf("%-20s %12.1f\n", "table rebuild", build);
+    printf("\nquadratic table vs formula, every setting\n");
+    printf("1ms buckets   %3u-%u ms: %u/%u steps differ\n", k_FirstExactInterval, k_FirstWideInterval - 1, mismatches[0], samples[0]);
+    printf("wider buckets %3u-%u ms: %u/%u steps differ, max %u (at %u ms)\n", k_FirstWideInterval, ROTARY_VELOCITY_RESET, mismatches[1], samples[1], maxError[1], maxErrorInterval[1]);
+
+    printf("\nstep at %u%% acceleration\n%-12s", DeviceSettings().accelerationPercentage, "ms/detent");
+    const uint16_t intervals[] = {10, 20, 30, 40, 60, 80, 120, 250};
+    for (uint16_t interval : intervals)
+        printf("%5u", interval);
+    printf("\n");
+    for (uint8_t curve = 0; curve < 3; curve++)
+    {
+        BuildAccelerationTable((AccelerationCurve)curve, DeviceSettings().accelerationPercentage);
+        printf("%-12s", k_CurveNames[curve]);
+        for (uint16_t interval : intervals)
+        {
+            g_PreviousSteps = 1;
+            printf("%5d", ComputeAcceleratedVolume(1, interval, 0));
+        }
+        printf("\n");
+    }
+    return mismatches[0] == 0 ? 0 : 1;
+}
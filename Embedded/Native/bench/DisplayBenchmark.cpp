@@ -0,0 +1,171 @@
+//********************************************************
+// PROJECT: MAXMIX
+//
+// DECRIPTION:
+// Draws the firmware screens through MonoCanvas with the
+// whole frame and a page at a time (DISPLAY_PAGE_BUFFER), and
+// through Adafruit_SSD1306 with its full frame, the way they
+// were drawn before. Reports host cycles per screen, the I2C
+// bytes and bus time per screen and the RAM of the display
+// object and its buffer. Every run is replayed into the
+// emulator's panel model to check it shows the same thing as
+// Adafruit_SSD1306, exits with 1 if a screen doesn't.
+// The paged canvas draws every screen once per page, its
+// cycles against the full canvas are the render cost of the
+// RAM saved, the full canvas against Adafruit_SSD1306 what
+// inlining the drawing gets back. On AVR the bus time at
+// DISPLAY_SPEED dominates either way.
+//
+// USAGE:
+// display-benchmark [ITERATIONS]
+//********************************************************
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "Ticks.h"
+#include "Native.h"
+#include "Panel.h"
+#include "DisplayVariant.h"
+
+static uint32_t s_Bytes;
+static uint32_t s_Transmissions;
+// The panel model parses every byte, it only sees the frames compared so it isn't timed.
+static bool s_Replay;
+
+static void OnTransmit(uint8_t address, const uint8_t *data, size_t length)
+{
+    s_Bytes += length;
+    s_Transmissions++;
+    if (s_Replay)
+        Panel::Receive(address, data, length);
+}
+
+SessionData g_ShortSession;
+SessionData g_LongSession;
+
+static const char *k_ScreenNames[SCREEN_MAX] = {
+    "splash",
+    "device select",
+    "device edit",
+    "app select scroll",
+    "app edit",
+    "game edit",
+    "peak meter",
+};
+
+struct Run
+{
+    const char *name;
+    const DisplayVariant *variant;
+};
+
+static const Run k_Runs[] = {
+    {"gfx", &k_GfxVariant},
+    {"canvas", &k_CanvasVariant},
+    {"canvas paged", &k_CanvasPagedVariant},
+};
+static const uint8_t k_RunsCount = sizeof(k_Runs) / sizeof(k_Runs[0]);
+
+struct Result
+{
+    double cycles;
+    double bytes;
+    double transmissions;
+    uint8_t ram[Panel::PAGES][Panel::WIDTH];
+};
+
+static void Measure(const Run &run, uint32_t iterations, Result *results)
+{
+    const DisplayVariant &variant = *run.variant;
+    s_Replay = true;
+    variant.begin();
+
+    for (uint8_t s = 0; s < SCREEN_MAX; s++)
+    {
+        variant.resetTimers();
+        s_Replay = false;
+        s_Bytes = 0;
+        s_Transmissions = 0;
+        uint64_t start = Ticks();
+        for (uint32_t i = 0; i < iterations; i++)
+            variant.draw(s, i);
+        results[s].cycles = (double)(Ticks() - start) / iterations;
+        results[s].bytes = (double)s_Bytes / iterations;
+        results[s].transmissions = (double)s_Transmissions / iterations;
+
+        // Same timer and level in every run, the panel should end up the same.
+        variant.resetTimers();
+        variant.updateTimers(4000);
+        s_Replay = true;
+        variant.draw(s, 7);
+        bool on;
+        Panel::Snapshot(results[s].ram, on);
+    }
+}
+
+// Start, address and stop around every transmission, 9 bits per byte with the ack.
+static double BusMicros(double bytes, double transmissions)
+{
+    return ((bytes + transmissions) * 9 + transmissions * 2) * 1000000.0 / DISPLAY_SPEED;
+}
+
+int main(int argc, char **argv)
+{
+    uint32_t iterations = argc > 1 ? strtoul(argv[1], NULL, 10) : 2000;
+
+    strcpy(g_ShortSession.name, "Speakers");
+    g_ShortSession.data.volume = 42;
+    g_ShortSession.data.isDefault = true;
+    strcpy(g_LongSession.name, "Music Player Deluxe");
+    g_LongSession.data.volume = 100;
+    g_LongSession.data.isMuted = true;
+
+    // Only the drawing and the transfer calls are timed, bus time is computed from the bytes sent.
+    Native::SetI2CHandler(OnTransmit);
+    Native::SetI2CWait(false);
+
+    static Result results[k_RunsCount][SCREEN_MAX];
+    for (uint8_t r = 0; r < k_RunsCount; r++)
+        Measure(k_Runs[r], iterations, results[r]);
+
+    printf("display RAM:");
+    for (uint8_t r = 0; r < k_RunsCount; r++)
+        printf(" %s %u bytes%s", k_Runs[r].name, k_Runs[r].variant->ram(), r + 1 < k_RunsCount ? "," : "\n\n");
+
+    // Ratios against Adafruit_SSD1306.
+    printf("%-18s", "cycles");
+    for (uint8_t r = 0; r < k_RunsCount; r++)
+        printf(" %12s", k_Runs[r].name);
+    for (uint8_t r = 1; r < k_RunsCount; r++)
+        printf(" %10s", k_Runs[r].name);
+    printf(" %6s\n", "same");
+    uint8_t differ = 0;
+    for (uint8_t s = 0; s < SCREEN_MAX; s++)
+    {
+        bool same = true;
+        printf("%-18s", k_ScreenNames[s]);
+        for (uint8_t r = 0; r < k_RunsCount; r++)
+            printf(" %12.0f", results[r][s].cycles);
+        for (uint8_t r = 1; r < k_RunsCount; r++)
+        {
+            printf(" %10.2f", results[r][s].cycles / results[0][s].cycles);
+            same &= memcmp(results[0][s].ram, results[r][s].ram, sizeof(results[0][s].ram)) == 0;
+        }
+        printf(" %6s\n", same ? "yes" : "NO");
+        differ += !same;
+    }
+
+    printf("\n%-18s", "bus bytes / us");
+    for (uint8_t r = 0; r < k_RunsCount; r++)
+        printf(" %17s", k_Runs[r].name);
+    printf("\n");
+    for (uint8_t s = 0; s < SCREEN_MAX; s++)
+    {
+        printf("%-18s", k_ScreenNames[s]);
+        for (uint8_t r = 0; r < k_RunsCount; r++)
+            printf(" %8.0f %8.0f", results[r][s].bytes, BusMicros(results[r][s].bytes, results[r][s].transmissions));
+        printf("\n");
+    }
+    return differ == 0 ? 0 : 1;
+}
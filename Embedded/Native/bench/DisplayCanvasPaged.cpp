@@ -0,0 +1,31 @@
+// Display.cpp drawing through MonoCanvas a page at a time, DISPLAY_PAGE_BUFFER, see DisplayVariant.h.
+#include "DisplayVariant.h"
+
+#define DISPLAY_CLASS SSD1306Canvas<DISPLAY_WIDTH, DISPLAY_HEIGHT, DISPLAY_ROTATION, 1>
+
+namespace CanvasPaged
+{
+    // Constants of Display.h, it was included outside.
+    namespace Display
+    {
+        using ::Display::DISPLAY_TIMER_A;
+        using ::Display::DISPLAY_TIMER_B;
+    } // namespace Display
+
+#include "Display.cpp"
+#include "DisplayScreens.h"
+
+    static void Begin(void)
+    {
+        Display::Initialize();
+        Display::SetPeakMeter(9);
+    }
+
+    // The buffer is a member.
+    static uint16_t Ram(void)
+    {
+        return sizeof(Display::display);
+    }
+} // namespace CanvasPaged
+
+const DisplayVariant k_CanvasPagedVariant = {CanvasPaged::Begin, CanvasPaged::Draw, CanvasPaged::Display::ResetTimers, CanvasPaged::Display::UpdateTimers, CanvasPaged::Ram};
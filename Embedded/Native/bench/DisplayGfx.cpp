@@ -0,0 +1,74 @@
+// Display.cpp drawing through Adafruit_SSD1306 and its 512 byte frame, as the firmware did
+// before MonoCanvas, see DisplayVariant.h. Only the benchmark draws with it, to compare.
+#include "DisplayVariant.h"
+
+// The calls Display.cpp makes that Adafruit_SSD1306 doesn't have. A frame is drawn once and
+// sent whole, the peak meter too: there are no pages nor partial updates.
+class GfxDisplay : public Adafruit_SSD1306
+{
+public:
+    GfxDisplay(int8_t resetPin) : Adafruit_SSD1306(DISPLAY_WIDTH, DISPLAY_HEIGHT, &Wire, resetPin) {}
+
+    bool begin(uint8_t vcc, uint8_t address)
+    {
+        bool result = Adafruit_SSD1306::begin(vcc, address);
+        setRotation(DISPLAY_ROTATION);
+        return result;
+    }
+
+    void firstPage(uint8_t = 0, uint8_t = 0) {}
+
+    bool nextPage()
+    {
+        display();
+        return false;
+    }
+
+    // A pixel at a time, Adafruit_SSD1306 has no blitter. Sprites are laid out rotated, their
+    // pixels are drawn unrotated where MonoCanvas puts them.
+    void drawSprite(int16_t x, int16_t y, const uint8_t *sprite, uint16_t color = WHITE)
+    {
+        int16_t w = pgm_read_byte(&sprite[0]);
+        int16_t h = pgm_read_byte(&sprite[1]);
+        SSD1306Canvas<DISPLAY_WIDTH, DISPLAY_HEIGHT, DISPLAY_ROTATION>::Rotate(x, y, w, h);
+
+        setRotation(0);
+        for (int16_t j = 0; j < h; j++)
+        {
+            for (int16_t i = 0; i < w; i++)
+            {
+                if (pgm_read_byte(&sprite[2 + j / 8 * w + i]) & (1 << (j & 7)))
+                    drawPixel(x + i, y + j, color);
+            }
+        }
+        setRotation(DISPLAY_ROTATION);
+    }
+};
+
+#define DISPLAY_CLASS GfxDisplay
+
+namespace Gfx
+{
+    // Constants of Display.h, it was included outside.
+    namespace Display
+    {
+        using ::Display::DISPLAY_TIMER_A;
+        using ::Display::DISPLAY_TIMER_B;
+    } // namespace Display
+
+#include "Display.cpp"
+#include "DisplayScreens.h"
+
+    static void Begin(void)
+    {
+        Display::Initialize();
+        Display::SetPeakMeter(9);
+    }
+
+    static uint16_t Ram(void)
+    {
+        return sizeof(Display::display) + DISPLAY_WIDTH * DISPLAY_HEIGHT / 8;
+    }
+} // namespace Gfx
+
+const DisplayVariant k_GfxVariant = {Gfx::Begin, Gfx::Draw, Gfx::Display::ResetTimers, Gfx::Display::UpdateTimers, Gfx::Ram};
@@ -0,0 +1,29 @@
+// Included in a variant's namespace after Display.cpp, no include guard on purpose.
+static void Draw(uint8_t screen, uint32_t i)
+{
+    switch (screen)
+    {
+    case SCREEN_SPLASH:
+        Display::SplashScreen();
+        break;
+    case SCREEN_DEVICE_SELECT:
+        Display::DeviceSelectScreen(&g_ShortSession, true, true, DisplayMode::MODE_OUTPUT);
+        break;
+    case SCREEN_DEVICE_EDIT:
+        Display::DeviceEditScreen(&g_ShortSession, "Out", DisplayMode::MODE_OUTPUT);
+        break;
+    case SCREEN_APP_SELECT_SCROLL:
+        Display::UpdateTimers(33);
+        Display::ApplicationSelectScreen(&g_LongSession, true, false, DisplayMode::MODE_APPLICATION);
+        break;
+    case SCREEN_APP_EDIT:
+        Display::ApplicationEditScreen(&g_LongSession, DisplayMode::MODE_APPLICATION);
+        break;
+    case SCREEN_GAME_EDIT:
+        Display::GameEditScreen(&g_ShortSession, &g_LongSession, DisplayMode::MODE_GAME);
+        break;
+    case SCREEN_PEAK_METER:
+        Display::UpdatePeakMeter(i & 15);
+        break;
+    }
+}
@@ -0,0 +1,38 @@
+#pragma once
+// Display.cpp is built into display-benchmark once per display class, each in a namespace
+// of its own, with DISPLAY_CLASS set to the class. Its includes come first so only
+// Display.cpp itself ends up in there.
+#include "Display.h"
+#include "src/MonoCanvas/SSD1306Canvas.h"
+
+enum BenchScreen : uint8_t
+{
+    SCREEN_SPLASH,
+    SCREEN_DEVICE_SELECT,
+    SCREEN_DEVICE_EDIT,
+    SCREEN_APP_SELECT_SCROLL,
+    SCREEN_APP_EDIT,
+    SCREEN_GAME_EDIT,
+    SCREEN_PEAK_METER,
+    SCREEN_MAX
+};
+
+struct DisplayVariant
+{
+    // Starts the display over.
+    void (*begin)(void);
+    // Frame i of a screen, scrolling and the meter move on every frame.
+    void (*draw)(uint8_t screen, uint32_t i);
+    void (*resetTimers)(void);
+    void (*updateTimers)(uint32_t deltaTime);
+    // Display object and buffer RAM.
+    uint16_t (*ram)(void);
+};
+
+// Defined in DisplayBenchmark.cpp
+extern SessionData g_ShortSession;
+extern SessionData g_LongSession;
+
+extern const DisplayVariant k_GfxVariant;
+extern const DisplayVariant k_CanvasVariant;
+extern const DisplayVariant k_CanvasPagedVariant;
@@ -0,0 +1,154 @@
+//********************************************************
+// PROJECT: MAXMIX
+//
+// DECRIPTION:
+// Compares the fixed screen elements drawn from Sprites.h on
+// the MonoCanvas with the text and geometry calls they
+// replaced, on the canvas and on Adafruit_SSD1306 as the
+// firmware drew them before. Reports host cycles per element,
+// the best of a few runs, and checks all three draw the same
+// pixels, exits with 1 if they don't. On AVR text also
+// formats the number with 32 bit divisions and every pixel is
+// a call, the gap is larger there.
+//
+// USAGE:
+// sprite-benchmark [ITERATIONS]
+//********************************************************
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "Ticks.h"
+#include "Native.h"
+#include "Config.h"
+#include "Sprites.h"
+#include "src/Adafruit_SSD1306/Adafruit_SSD1306.h"
+#include "src/MonoCanvas/MonoCanvas.h"
+
+// Whole frame, the cost of drawing without the page clipping.
+class Canvas : public MonoCanvas<Canvas, DISPLAY_WIDTH, DISPLAY_HEIGHT, DISPLAY_ROTATION>
+{
+    friend class MonoCanvas<Canvas, DISPLAY_WIDTH, DISPLAY_HEIGHT, DISPLAY_ROTATION>;
+    void SendWindow(uint8_t, uint8_t, uint8_t, uint8_t) {}
+    void SendData(const uint8_t *, uint8_t, uint8_t) {}
+};
+
+//---------------------------------------------------------
+// Elements, as Display.cpp drew them and as it does now
+//---------------------------------------------------------
+// Volume number of the application edit screen, its rows don't line up with the pages.
+static const uint8_t VOLUME_X = DISPLAY_WIDTH - DISPLAY_AREA_CENTER_MARGIN_SIDE;
+static const uint8_t VOLUME_Y = DISPLAY_CHAR_HEIGHT_X1 + DISPLAY_MARGIN_X2;
+
+template <class D, uint8_t VOLUME>
+static void VolumeText(D &display)
+{
+    uint8_t x0 = VOLUME_X - DISPLAY_CHAR_WIDTH_X2;
+    if (VOLUME > 9)
+        x0 = x0 - DISPLAY_CHAR_WIDTH_X2 - DISPLAY_CHAR_SPACING_X2;
+    if (VOLUME > 99)
+        x0 = x0 - DISPLAY_CHAR_WIDTH_X2 - DISPLAY_CHAR_SPACING_X2;
+
+    display.setTextSize(2);
+    display.setTextColor(WHITE);
+    display.setCursor(x0, VOLUME_Y);
+    display.print(VOLUME);
+}
+
+template <uint8_t VOLUME>
+static void VolumeSprites(Canvas &display)
+{
+    uint8_t x0 = VOLUME_X;
+    uint8_t volume = VOLUME;
+    do
+    {
+        x0 -= DISPLAY_CHAR_WIDTH_X2;
+        display.drawSprite(x0, VOLUME_Y, SPRITE_DIGITS_X2[volume % 10]);
+        x0 -= DISPLAY_CHAR_SPACING_X2;
+        volume /= 10;
+    } while (volume > 0);
+}
+
+template <class D>
+static void ArrowTriangles(D &display)
+{
+    const uint8_t y0 = DISPLAY_MARGIN_X2 + DISPLAY_WIDGET_ARROW_SIZE_X1;
+    display.fillTriangle(0, y0, DISPLAY_WIDGET_ARROW_SIZE_X1, y0 - DISPLAY_WIDGET_ARROW_SIZE_X1, DISPLAY_WIDGET_ARROW_SIZE_X1, y0 + DISPLAY_WIDGET_ARROW_SIZE_X1, WHITE);
+    display.fillTriangle(DISPLAY_WIDTH - 1, y0, DISPLAY_WIDTH - 1 - DISPLAY_WIDGET_ARROW_SIZE_X1, y0 - DISPLAY_WIDGET_ARROW_SIZE_X1, DISPLAY_WIDTH - 1 - DISPLAY_WIDGET_ARROW_SIZE_X1, y0 + DISPLAY_WIDGET_ARROW_SIZE_X1, WHITE);
+}
+
+static void ArrowSprites(Canvas &display)
+{
+    display.drawSprite(0, DISPLAY_MARGIN_X2, SPRITE_ARROW_LEFT);
+    display.drawSprite(DISPLAY_WIDTH - 1 - DISPLAY_WIDGET_ARROW_SIZE_X1, DISPLAY_MARGIN_X2, SPRITE_ARROW_RIGHT);
+}
+
+struct Element
+{
+    const char *name;
+    void (*gfx)(Adafruit_SSD1306 &display);
+    void (*canvas)(Canvas &display);
+    void (*sprite)(Canvas &display);
+};
+
+static const Element k_Elements[] = {
+    {"volume 100", VolumeText<Adafruit_SSD1306, 100>, VolumeText<Canvas, 100>, VolumeSprites<100>},
+    {"volume 42", VolumeText<Adafruit_SSD1306, 42>, VolumeText<Canvas, 42>, VolumeSprites<42>},
+    {"arrows", ArrowTriangles<Adafruit_SSD1306>, ArrowTriangles<Canvas>, ArrowSprites},
+};
+static const uint8_t k_ElementsCount = sizeof(k_Elements) / sizeof(k_Elements[0]);
+
+template <class D>
+static double Cycles(D &display, void (*draw)(D &), uint32_t iterations)
+{
+    // Best of a few runs, the host is busy with other things too.
+    double best = 0;
+    for (uint8_t run = 0; run < 5; run++)
+    {
+        uint64_t start = Ticks();
+        for (uint32_t i = 0; i < iterations; i++)
+            draw(display);
+        double cycles = (double)(Ticks() - start) / iterations;
+        if (run == 0 || cycles < best)
+            best = cycles;
+    }
+    return best;
+}
+
+// Frame with only the element drawn.
+template <class D>
+static const uint8_t *Frame(D &display, void (*draw)(D &))
+{
+    display.clearDisplay();
+    draw(display);
+    return display.getBuffer();
+}
+
+int main(int argc, char **argv)
+{
+    uint32_t iterations = argc > 1 ? strtoul(argv[1], NULL, 10) : 20000;
+
+    Native::SetI2CWait(false);
+    static Canvas canvas;
+    static Adafruit_SSD1306 gfx(DISPLAY_WIDTH, DISPLAY_HEIGHT, &Wire, -1);
+    gfx.begin(SSD1306_SWITCHCAPVCC, DISPLAY_ADDRESS);
+    gfx.setRotation(DISPLAY_ROTATION);
+    gfx.setTextWrap(false);
+    canvas.setTextWrap(false);
+
+    printf("%-12s %18s %21s %7s %6s\n", "cycles", "gfx text/geometry", "canvas text/geometry", "sprite", "same");
+    uint8_t differ = 0;
+    for (uint8_t e = 0; e < k_ElementsCount; e++)
+    {
+        const Element &element = k_Elements[e];
+        static uint8_t sprite[DISPLAY_WIDTH * DISPLAY_HEIGHT / 8];
+        memcpy(sprite, Frame(canvas, element.sprite), sizeof(sprite));
+        bool same = memcmp(sprite, Frame(canvas, element.canvas), sizeof(sprite)) == 0 &&
+                    memcmp(sprite, Frame(gfx, element.gfx), sizeof(sprite)) == 0;
+
+        printf("%-12s %18.0f %21.0f %7.0f %6s\n", element.name, Cycles(gfx, element.gfx, iterations),
+               Cycles(canvas, element.canvas, iterations), Cycles(canvas, element.sprite, iterations), same ? "yes" : "NO");
+        differ += !same;
+    }
+    return differ == 0 ? 0 : 1;
+}
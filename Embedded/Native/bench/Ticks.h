@@ -0,0 +1,17 @@
+#pragma once
+// Timing of the benchmarks. Include it before Arduino.h, its min and max macros break <chrono>.
+#include <stdint.h>
+#include <chrono>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+// Cycle counter where available, nanoseconds otherwise.
+static inline uint64_t Ticks()
+{
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+}
@@ -0,0 +1,36 @@
+# Builds a single translation unit out of the sketch .ino files, like the Arduino builder:
+# every #include first, then a prototype for each top level function, then the sketch bodies.
+# The .ino files are configure dependencies, so new functions are picked up on the next build.
+function(maxmix_generate_sketch output)
+    set(includes "")
+    set(prototypes "")
+    set(bodies "")
+    foreach(ino ${ARGN})
+        set_property(DIRECTORY APPEND PROPERTY CMAKE_CONFIGURE_DEPENDS ${ino})
+
+        file(STRINGS ${ino} lines REGEX "^#include")
+        foreach(line ${lines})
+            string(APPEND includes "${line}\n")
+        endforeach()
+
+        # Function definitions start in column 0 and have their opening brace on the next line.
+        file(STRINGS ${ino} lines REGEX "^([A-Za-z_][A-Za-z0-9_:<>]*[ \t*&]+)+[A-Za-z_][A-Za-z0-9_]*[ \t]*\\([^;{}]*\\)[ \t\r]*$")
+        foreach(line ${lines})
+            if(NOT line MATCHES "^(else|return|if|while|for|switch|case|delete|new)[ \t(]")
+                string(STRIP "${line}" line)
+                string(APPEND prototypes "${line};\n")
+            endif()
+        endforeach()
+
+        string(APPEND bodies "#include \"${ino}\"\n")
+    endforeach()
+
+    set(content "// Generated by cmake/Sketch.cmake, do not edit.\n${includes}\n${prototypes}\n${bodies}")
+    # Only touch the file when it changes to avoid needless rebuilds.
+    if(EXISTS ${output})
+        file(READ ${output} previous)
+    endif()
+    if(NOT "${previous}" STREQUAL "${content}")
+        file(WRITE ${output} "${content}")
+    endif()
+endfunction()
@@ -0,0 +1,149 @@
+//********************************************************
+// PROJECT: MAXMIX
+//
+// DECRIPTION:
+// Generates MaxMix/Sprites.h. Every fixed screen element is
+// drawn with the geometry or text calls Display.cpp used for
+// it, on a MonoCanvas with the display's size and rotation,
+// and its bytes are cut out of the buffer. drawSprite() then
+// copies the same pixels. Sizes come from Config.h, run it
+// again after changing them or DISPLAY_ROTATION.
+//
+// USAGE:
+// sprite-generator > ../MaxMix/Sprites.h
+//********************************************************
+#include <stdio.h>
+#include <stdlib.h>
+#include <vector>
+
+#include "Config.h"
+#include "src/MonoCanvas/MonoCanvas.h"
+
+class Capture : public MonoCanvas<Capture, DISPLAY_WIDTH, DISPLAY_HEIGHT, DISPLAY_ROTATION>
+{
+    friend class MonoCanvas<Capture, DISPLAY_WIDTH, DISPLAY_HEIGHT, DISPLAY_ROTATION>;
+
+public:
+    bool GetBufferPixel(uint8_t x, uint8_t y) const { return buffer[(y / 8) * DISPLAY_WIDTH + x] & (1 << (y & 7)); }
+
+private:
+    void SendWindow(uint8_t, uint8_t, uint8_t, uint8_t) {}
+    void SendData(const uint8_t *, uint8_t, uint8_t) {}
+};
+
+// Elements are drawn away from the edges, any position works once cut out.
+static const uint8_t ORIGIN_X = 8;
+static const uint8_t ORIGIN_Y = 8;
+
+struct Element
+{
+    const char *name;
+    uint8_t width;
+    uint8_t height;
+    // Draws the element with its top left corner at x, y.
+    void (*draw)(Capture &canvas, int16_t x, int16_t y, uint8_t index);
+    uint8_t count; // More than 1 for a set, SPRITE_NAME[index]
+};
+
+static const uint8_t A = DISPLAY_WIDGET_ARROW_SIZE_X1;
+
+static const Element k_Elements[] = {
+    {"SPRITE_DIGITS_X2", DISPLAY_CHAR_WIDTH_X2, DISPLAY_CHAR_HEIGHT_X2, [](Capture &c, int16_t x, int16_t y, uint8_t i) { c.drawChar(x, y, '0' + i, WHITE, WHITE, 2); }, 10},
+    {"SPRITE_ARROW_LEFT", A + 1, A * 2 + 1, [](Capture &c, int16_t x, int16_t y, uint8_t) { c.fillTriangle(x, y + A, x + A, y, x + A, y + A * 2, WHITE); }, 1},
+    {"SPRITE_ARROW_RIGHT", A + 1, A * 2 + 1, [](Capture &c, int16_t x, int16_t y, uint8_t) { c.fillTriangle(x + A, y + A, x, y, x, y + A * 2, WHITE); }, 1},
+};
+
+// Sprite bytes of one element, see MonoCanvas::drawSprite().
+static std::vector<uint8_t> Rasterize(const Element &element, uint8_t index)
+{
+    Capture canvas;
+
+    // Where the element's rectangle lands in the buffer once rotated.
+    canvas.clearDisplay();
+    canvas.fillRect(ORIGIN_X, ORIGIN_Y, element.width, element.height, WHITE);
+    uint8_t x0 = DISPLAY_WIDTH, y0 = DISPLAY_HEIGHT, x1 = 0, y1 = 0;
+    for (uint8_t y = 0; y < DISPLAY_HEIGHT; y++)
+    {
+        for (uint8_t x = 0; x < DISPLAY_WIDTH; x++)
+        {
+            if (canvas.GetBufferPixel(x, y))
+            {
+                x0 = min(x0, x);
+                y0 = min(y0, y);
+                x1 = max(x1, x);
+                y1 = max(y1, y);
+            }
+        }
+    }
+
+    canvas.clearDisplay();
+    element.draw(canvas, ORIGIN_X, ORIGIN_Y, index);
+
+    uint8_t columns = x1 - x0 + 1;
+    uint8_t rows = y1 - y0 + 1;
+    std::vector<uint8_t> sprite(2 + columns * ((rows + 7) / 8));
+    sprite[0] = element.width;
+    sprite[1] = element.height;
+    for (uint8_t y = 0; y < DISPLAY_HEIGHT; y++)
+    {
+        for (uint8_t x = 0; x < DISPLAY_WIDTH; x++)
+        {
+            if (!canvas.GetBufferPixel(x, y))
+                continue;
+            if (x < x0 || x > x1 || y < y0 || y > y1)
+            {
+                fprintf(stderr, "%s[%u] draws outside of its %ux%u rectangle\n", element.name, index, element.width, element.height);
+                exit(1);
+            }
+            uint8_t r = y - y0;
+            sprite[2 + (r / 8) * columns + x - x0] |= 1 << (r & 7);
+        }
+    }
+    return sprite;
+}
+
+// Size, then a line per page of columns.
+static void PrintBytes(const std::vector<uint8_t> &sprite, const char *indent)
+{
+    uint8_t columns = DISPLAY_ROTATION & 1 ? sprite[1] : sprite[0];
+    printf("%s%u, %u,\n", indent, sprite[0], sprite[1]);
+    for (size_t i = 2; i < sprite.size(); i++)
+        printf("%s0x%02X,%s", (i - 2) % columns == 0 ? indent : "", sprite[i], (i - 1) % columns == 0 ? "\n" : " ");
+}
+
+int main()
+{
+    printf("#pragma once\n");
+    printf("//********************************************************\n");
+    printf("// PROJECT: MAXMIX\n");
+    printf("//\n");
+    printf("// DECRIPTION:\n");
+    printf("// Generated by Native/tools/SpriteGenerator.cpp, don't edit.\n");
+    printf("// Fixed screen elements for drawSprite(), %ux%u display\n", DISPLAY_WIDTH, DISPLAY_HEIGHT);
+    printf("// with DISPLAY_ROTATION %u.\n", DISPLAY_ROTATION);
+    printf("//********************************************************\n");
+    printf("\n#include <Arduino.h>\n");
+
+    for (const Element &element : k_Elements)
+    {
+        std::vector<uint8_t> first = Rasterize(element, 0);
+        printf("\n");
+        if (element.count == 1)
+        {
+            printf("static const uint8_t %s[] PROGMEM = {\n", element.name);
+            PrintBytes(first, "    ");
+            printf("};\n");
+            continue;
+        }
+
+        printf("static const uint8_t %s[%u][%zu] PROGMEM = {\n", element.name, element.count, first.size());
+        for (uint8_t i = 0; i < element.count; i++)
+        {
+            printf("    {\n");
+            PrintBytes(Rasterize(element, i), "        ");
+            printf("    },\n");
+        }
+        printf("};\n");
+    }
+    return 0;
+}